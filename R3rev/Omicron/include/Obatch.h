@@ -0,0 +1,111 @@
+/**
+ * @file 
+ * @brief Omicron batched inverse Fourier transforms.
+ */
+#ifndef __Obatch__
+#define __Obatch__
+
+#include <fftw3.h>
+
+using namespace std;
+
+/**
+ * @brief Batch of inverse Fourier transforms of the same size.
+ * @details This class is designed to group the inverse Fourier transforms of the frequency bands of a Q-plane having the same number of time tiles.
+ * Instead of one fft plan per band, the rows of the batch are packed in one contiguous buffer and transformed with a single fftw plan (`fftw_plan_many_dft()`).
+ *
+ * A row is filled with SetRow(): the input data are multiplied by a complex window (see OsimdWindow()) and written in the row, starting at a given offset and wrapping around the end of the row (negative frequencies).
+ * The rest of the row is set to 0.
+ * All the rows are then transformed in place with Execute().
+ *
+ * The fftw planner is not thread-safe: Obatch objects must be constructed and destroyed by one thread at a time.
+ * Once constructed, different Obatch objects can be executed by different threads at the same time.
+ * The plan is created with `FFTW_ESTIMATE`, so the buffer content is not modified by the constructor.
+ */
+class Obatch{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Obatch class.
+   * @details The row buffer is allocated and set to 0.
+   * @param[in] aSize Number of complex samples in a row: must be strictly positive.
+   * @param[in] aRowN Number of rows: must be strictly positive.
+   */
+  Obatch(const unsigned int aSize, const unsigned int aRowN);
+
+  /**
+   * @brief Destructor of the Obatch class.
+   */
+  virtual ~Obatch(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the status of the object.
+   * @details false is returned if the plan cannot be created.
+   */
+  inline bool GetStatus(void){ return plan!=NULL; };
+
+  /**
+   * @brief Returns the number of complex samples in a row.
+   */
+  inline unsigned int GetSize(void){ return size; };
+
+  /**
+   * @brief Returns the number of rows.
+   */
+  inline unsigned int GetRowN(void){ return rown; };
+
+  /**
+   * @brief Returns a row of the batch.
+   * @details The rows are contiguous: row \f$r\f$ starts at sample \f$r\times\f$ GetSize().
+   * @param[in] aRowIndex Row index: must be valid.
+   */
+  inline fftw_complex* GetRow(const unsigned int aRowIndex){ return buffer+(long unsigned int)aRowIndex*(long unsigned int)size; };
+
+  /**
+   * @brief Fills a row with windowed data.
+   * @details The row sample \f$(o+k) \bmod N\f$ is set to \f$x_k \times (w^r_k + i w^i_k)\f$ for \f$0\le k<n\f$, where \f$o\f$ is the offset and \f$N\f$ is the row size.
+   * The other row samples are set to 0.
+   * @param[in] aRowIndex Row index: must be valid.
+   * @param[in] aN Number of complex samples \f$n\f$: must be smaller than or equal to the row size.
+   * @param[in] aIn Input complex vector \f$x\f$ (interleaved).
+   * @param[in] aWindowRe Window, real part \f$w^r\f$.
+   * @param[in] aWindowIm Window, imaginary part \f$w^i\f$.
+   * @param[in] aOffset Row index of the first sample \f$o\f$.
+   */
+  void SetRow(const unsigned int aRowIndex, const unsigned int aN, const double *aIn,
+              const double *aWindowRe, const double *aWindowIm, const unsigned int aOffset=0);
+
+  /**
+   * @brief Computes the inverse Fourier transform of all the rows, in place.
+   * @details The transform is not normalized: \f$y_n = \sum_k x_k e^{2i\pi kn/N}\f$.
+   */
+  void Execute(void);
+
+  /**
+   * @brief Returns the squared modulus of a row sample.
+   * @param[in] aRowIndex Row index: must be valid.
+   * @param[in] aIndex Sample index: must be valid.
+   */
+  inline double GetNorm2(const unsigned int aRowIndex, const unsigned int aIndex){
+    fftw_complex *row = GetRow(aRowIndex);
+    return row[aIndex][0]*row[aIndex][0]+row[aIndex][1]*row[aIndex][1];
+  };
+
+ private:
+
+  unsigned int size;        ///< Number of complex samples in a row.
+  unsigned int rown;        ///< Number of rows.
+  fftw_complex *buffer;     ///< Rows.
+  fftw_plan plan;           ///< Batched backward plan.
+
+};
+
+#endif
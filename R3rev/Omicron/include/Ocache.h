@@ -0,0 +1,184 @@
+/**
+ * @file
+ * @brief Omicron cache of decoded frame vectors.
+ */
+#ifndef __Ocache__
+#define __Ocache__
+
+#include "Ogwf.h"
+#include "Opool.h"
+#include <list>
+#include <set>
+#include <tuple>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+using namespace std;
+
+/**
+ * @brief Cache of decoded frame vectors, filled in parallel.
+ * @details This class is designed to take the decompression of frame vectors (see Ogwf) out of the data loading.
+ * The decoded vectors (blocks) are kept in memory, in their native type, and they are identified by the frame file path, the channel name and the GPS time of the first sample.
+ *
+ * The blocks of a time range are decoded with Decode(), for a list of frame files and a list of channels.
+ * The blocks are distributed over a pool of threads (see Opool): one task per block.
+ * This function is meant to be called from a background thread, for the next chunk (see Oprefetch), while the current chunk is processed.
+ *
+ * The data are then collected with Read(), which copies the samples from the cached blocks to the caller's buffer.
+ * If a block is being decoded by Decode(), Read() waits for it. If a block is not in the cache, it is decoded by the calling thread (and cached).
+ *
+ * The memory used by the blocks is limited by a budget. When the budget is exceeded, the least recently used blocks are removed from the cache.
+ * A block larger than the budget is never cached.
+ * The blocks are reference-counted: a block removed from the cache while being copied by Read() remains valid until the copy is done.
+ * @note The Ogwf objects given to Decode() and Read() must remain valid while these functions run. They are not owned by this class.
+ */
+class Ocache{
+
+ public:
+
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Ocache class.
+   * @param[in] aThreadN Number of decoding threads (see Opool).
+   * @param[in] aMemoryBudget Memory budget [bytes].
+   * @param[in] aVerbosity Verbosity level.
+   */
+  Ocache(const unsigned int aThreadN, const long unsigned int aMemoryBudget, const unsigned int aVerbosity=0);
+
+  /**
+   * @brief Destructor of the Ocache class.
+   */
+  virtual ~Ocache(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Decodes the blocks of a time range in parallel.
+   * @details The blocks overlapping the time range are listed for all the files and all the channels.
+   * The blocks which are not cached (or already being decoded) are decoded by the thread pool.
+   * This function returns when all the blocks are decoded.
+   * @returns The number of blocks decoded by this call.
+   * @param[in] aFiles Frame files.
+   * @param[in] aChannels Channel names.
+   * @param[in] aGpsStart GPS start time [s].
+   * @param[in] aGpsEnd GPS end time [s].
+   */
+  unsigned int Decode(const vector<Ogwf*> &aFiles, const vector<string> &aChannels,
+                      const double aGpsStart, const double aGpsEnd);
+
+  /**
+   * @brief Reads the data of a channel in a native buffer.
+   * @details This function is equivalent to Ogwf::Read(), but the samples are copied from the cached blocks.
+   * @returns The number of samples written in the buffer. 0 is returned if the native type or the sampling frequency do not match, or if a block cannot be decoded.
+   * @param[in] aFile Frame file.
+   * @param[in] aChannelName Channel name.
+   * @param[in] aGpsStart GPS time of the first sample of the buffer [s].
+   * @param[in] aSize Number of samples in the buffer.
+   * @param[out] aBuffer Buffer of aSize samples of native type aType, allocated by the caller.
+   * @param[in] aType Native type of the buffer.
+   * @param[in] aSamplingFrequency Sampling frequency [Hz].
+   */
+  long unsigned int Read(Ogwf *aFile, const string aChannelName, const double aGpsStart,
+                         const long unsigned int aSize, void *aBuffer,
+                         const OgwfType aType, const double aSamplingFrequency);
+
+  /**
+   * @brief Removes all the blocks from the cache.
+   */
+  void Clear(void);
+
+  /**
+   * @brief Returns the memory used by the cached blocks [bytes].
+   */
+  inline long unsigned int GetMemoryUsed(void){
+    lock_guard<mutex> lock(mtx);
+    return used;
+  };
+
+  /**
+   * @brief Returns the number of blocks found in the cache by Read().
+   */
+  inline long unsigned int GetHitN(void){
+    lock_guard<mutex> lock(mtx);
+    return hit_n;
+  };
+
+  /**
+   * @brief Returns the number of blocks decoded by Read().
+   */
+  inline long unsigned int GetMissN(void){
+    lock_guard<mutex> lock(mtx);
+    return miss_n;
+  };
+
+ private:
+
+  typedef tuple<string, string, double> Key; ///< Block identifier: file path, channel name, GPS start time.
+
+  /**
+   * @brief Decoded block.
+   */
+  struct Block{
+    double start;                   ///< GPS time of the first sample [s].
+    vector<char> data;              ///< Samples (native type).
+    long unsigned int size;         ///< Data size [bytes].
+  };
+
+  /**
+   * @brief Cache entry: block and position in the LRU list.
+   */
+  typedef pair< shared_ptr<Block>, list<Key>::iterator > Entry;
+
+  unsigned int fVerbosity;          ///< Verbosity level.
+  Opool *pool;                      ///< Decoding threads.
+  mutex run_mtx;                    ///< Decode() mutex: the thread pool is not re-entrant.
+  mutex mtx;                        ///< Cache mutex.
+  condition_variable cv;            ///< Signals a decoded block.
+  std::map<Key, Entry> blocks;      ///< Cached blocks.
+  list<Key> lru;                    ///< Blocks, from the most to the least recently used.
+  set<Key> pending;                 ///< Blocks being decoded by Decode().
+  long unsigned int budget;         ///< Memory budget [bytes].
+  long unsigned int used;           ///< Memory used by the cached blocks [bytes].
+  long unsigned int hit_n;          ///< Number of blocks found in the cache by Read().
+  long unsigned int miss_n;         ///< Number of blocks decoded by Read().
+
+  /**
+   * @brief Returns the decoded size of a block [bytes].
+   * @param[in] aFile Frame file.
+   * @param[in] aVectorIndex Vector index in the frame file.
+   */
+  static long unsigned int GetBlockSize(Ogwf *aFile, const unsigned int aVectorIndex);
+
+  /**
+   * @brief Decodes a block.
+   * @returns nullptr if the block cannot be decoded.
+   * @param[in] aFile Frame file.
+   * @param[in] aVectorIndex Vector index in the frame file.
+   */
+  static shared_ptr<Block> MakeBlock(Ogwf *aFile, const unsigned int aVectorIndex);
+
+  /**
+   * @brief Returns a cached block.
+   * @details If the block is being decoded, this function waits for it.
+   * @returns nullptr if the block is not cached.
+   * @param[in] aKey Block identifier.
+   */
+  shared_ptr<Block> Get(const Key &aKey);
+
+  /**
+   * @brief Inserts a block in the cache.
+   * @details The least recently used blocks are removed to fit the budget.
+   * @pre The cache mutex must be locked and the block size must be smaller than the budget.
+   * @param[in] aKey Block identifier.
+   * @param[in] aBlock Block.
+   */
+  void Insert(const Key &aKey, shared_ptr<Block> aBlock);
+
+};
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file 
+ * @brief Omicron fused data conditioning.
+ */
+#ifndef __Ocondition__
+#define __Ocondition__
+
+#include "Oconfig.h"
+#include "Odecimator.h"
+
+using namespace std;
+
+/**
+ * @brief Fused conditioning of a data vector.
+ * @details This class is designed to condition a data vector in a single sweep:
+ * - The DC component is removed.
+ * - The data is high-pass-filtered (optional).
+ * - The data is decimated to the working frequency (see Odecimator).
+ * - The data is multiplied by a window.
+ *
+ * The mean of the input vector is first computed (read-only pass).
+ * Then the input vector is processed in blocks of O_COND_BLOCK_SIZE samples: each block is copied in a scratch buffer, where the high-pass filter is applied.
+ * The block is then pushed to the polyphase decimator which only computes the output samples.
+ * The output samples are multiplied by the window.
+ * As a result, the input vector is read twice and the output vector is written once, while the filters operate on data in the cache.
+ *
+ * The high-pass filter is a Butterworth filter implemented as a cascade of second-order sections (bilinear transform).
+ * The anti-aliasing filter is a linear-phase FIR filter with a cutoff at 0.9 times the Nyquist frequency of the working frequency.
+ * The filter states are reset for every data vector.
+ *
+ * Only integer decimation factors are supported: the native frequency must be a multiple of the working frequency.
+ * Use IsValid() to check this.
+ */
+class Ocondition{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Ocondition class.
+   * @details The filters are designed.
+   * @param[in] aNativeFrequency Native sampling frequency [Hz].
+   * @param[in] aWorkingFrequency Working sampling frequency [Hz].
+   * @param[in] aHighPassFrequency High-pass frequency [Hz]. Use a value smaller or equal to 0 to not high-pass the data.
+   * @param[in] aOrder Order of the Butterworth high-pass filter. An odd order is rounded up to the next even order (the filter is a cascade of second-order sections); the minimum order is 2.
+   */
+  Ocondition(const unsigned int aNativeFrequency, const unsigned int aWorkingFrequency,
+             const double aHighPassFrequency, const unsigned int aOrder=8);
+
+  /**
+   * @brief Destructor of the Ocondition class.
+   */
+  virtual ~Ocondition(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns true if the decimation factor is an integer.
+   */
+  inline bool IsValid(void){ return ratio>0; };
+
+  /**
+   * @brief Returns the native sampling frequency [Hz].
+   */
+  inline unsigned int GetNativeFrequency(void){ return native; };
+
+  /**
+   * @brief Returns the working sampling frequency [Hz].
+   */
+  inline unsigned int GetWorkingFrequency(void){ return working; };
+
+  /**
+   * @brief Returns the high-pass frequency [Hz].
+   * @details 0 is returned if the data is not high-passed.
+   */
+  inline double GetHighPassFrequency(void){ return highpass; };
+
+  /**
+   * @brief Returns the order of the Butterworth high-pass filter.
+   * @details This is the constructor order, rounded up to an even number.
+   */
+  inline unsigned int GetOrder(void){ return 2*nsos; };
+
+  /**
+   * @brief Conditions a data vector.
+   * @details The input vector can be given in its native type (for example `float` or `short` samples, see Ogwf): the samples are converted to double precision when they are copied in the block buffer. There is no other conversion.
+   * @returns false if the vector sizes are inconsistent or if the decimation factor is not an integer.
+   * @param[in] aInSize Input vector size (native frequency).
+   * @param[in] aIn Input vector.
+   * @param[in] aOutSize Output vector size (working frequency): must be aInSize divided by the decimation factor.
+   * @param[out] aOut Output vector. It must be allocated with aOutSize values.
+   * @param[in] aWindow Window to apply to the output vector (aOutSize values). Use NULL to not apply a window.
+   */
+  template <typename T>
+  inline bool Process(const unsigned int aInSize, const T *aIn,
+                      const unsigned int aOutSize, double *aOut, const double *aWindow=NULL){
+    if(ratio==0) return false;
+    if((long unsigned int)aOutSize*(long unsigned int)ratio!=(long unsigned int)aInSize) return false;
+
+    // DC component
+    double mean = 0.0;
+    for(unsigned int i=0; i<aInSize; i++) mean += (double)aIn[i];
+    mean /= (double)aInSize;
+
+    // reset filters
+    for(unsigned int s=0; s<2*nhp; s++) state[s] = 0.0;
+    if(decimator!=NULL) decimator->Reset();
+
+    // block sweep
+    unsigned int o = 0, ow = 0;
+    for(unsigned int i0=0; i0<aInSize; i0+=O_COND_BLOCK_SIZE){
+      unsigned int n = TMath::Min((unsigned int)O_COND_BLOCK_SIZE, aInSize-i0);
+      for(unsigned int i=0; i<n; i++) block[i] = (double)aIn[i0+i]-mean;
+
+      // high-pass
+      for(unsigned int s=0; s<nhp; s++) Filter(n, 5*s, 2*s);
+
+      // decimation
+      if(decimator==NULL){
+        memcpy(aOut+o, block, n*sizeof(double));
+        o += n;
+      }
+      else o += decimator->Push(n, block, aOut+o);
+
+      // window (new output samples)
+      if(aWindow!=NULL) for(; ow<o; ow++) aOut[ow] *= aWindow[ow];
+    }
+
+    // last output samples
+    if(decimator!=NULL) o += decimator->Flush(aOut+o);
+    if(aWindow!=NULL) for(; ow<o; ow++) aOut[ow] *= aWindow[ow];
+
+    return true;
+  };
+
+ private:
+
+  unsigned int native;  ///< Native sampling frequency [Hz].
+  unsigned int working; ///< Working sampling frequency [Hz].
+  unsigned int ratio;   ///< Decimation factor (0 if not an integer).
+  double highpass;      ///< High-pass frequency [Hz] (0 = no high-pass).
+  unsigned int nsos;    ///< Number of second-order sections per filter.
+  unsigned int nhp;     ///< Number of high-pass second-order sections.
+  double *sos;          ///< Second-order section coefficients: b0, b1, b2, a1, a2.
+  double *state;        ///< Second-order section states (transposed direct form II).
+  double *block;        ///< Block scratch buffer.
+  Odecimator *decimator;///< Polyphase decimator (NULL if the decimation factor is 1).
+
+  /**
+   * @brief Designs a Butterworth high-pass second-order section.
+   * @param[in] aSectionIndex Section index in the filter cascade.
+   * @param[in] aFrequency Cutoff frequency [Hz].
+   * @param[in] aOffset Coefficient offset in sos.
+   */
+  void MakeSection(const unsigned int aSectionIndex, const double aFrequency, const unsigned int aOffset);
+
+  /**
+   * @brief Applies a second-order section to the block.
+   * @param[in] aN Number of samples in the block.
+   * @param[in] aOffset Coefficient offset in sos.
+   * @param[in] aStateOffset State offset.
+   */
+  void Filter(const unsigned int aN, const unsigned int aOffset, const unsigned int aStateOffset);
+
+};
+
+#endif
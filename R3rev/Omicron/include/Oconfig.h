@@ -25,6 +25,18 @@ using namespace std;
  */
 #define O_THUMBNAIL_RATIO 0.3
 
+/**
+ * @brief Number of input samples in a block of the fused conditioning.
+ * @details The data are conditioned block by block (see Ocondition): a block and the filter states should fit in the L1/L2 cache.
+ */
+#define O_COND_BLOCK_SIZE 4096
+
+/**
+ * @brief Size of the chunk cache of the HDF5 strain datasets [bytes].
+ * @details Consecutive time chunks overlap: the dataset chunks read for a time chunk should be kept for the next one (see Oh5).
+ */
+#define O_H5_CHUNK_CACHE 16777216
+
 /**
  * @brief Number of seconds in a year.
  * @todo Move this to GWOLLUM.
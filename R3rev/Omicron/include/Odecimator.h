@@ -0,0 +1,122 @@
+/**
+ * @file 
+ * @brief Omicron polyphase decimator.
+ */
+#ifndef __Odecimator__
+#define __Odecimator__
+
+#include "Oconfig.h"
+#include "Osimd.h"
+#include <TMath.h>
+
+using namespace std;
+
+/**
+ * @brief Decimates a data stream by an integer factor.
+ * @details This class is designed to low-pass filter and decimate a data stream by an integer factor \f$R\f$ in one step.
+ * The anti-aliasing filter is a linear-phase FIR filter of length \f$L=2RK+1\f$: a windowed sinc (Kaiser window).
+ * Only the output samples are computed: the output sample \f$m\f$ is the dot product of the filter with the input samples \f$x_{mR-RK}\f$ to \f$x_{mR+RK}\f$.
+ * This is the direct form of the polyphase decomposition: each output sample only costs \f$L\f$ multiply-adds, while filtering at the native rate costs \f$RL\f$.
+ * The dot products are vectorized: see OsimdDot().
+ *
+ * The filter is centered: there is no time delay between the input and the output.
+ * The data stream is pushed in pieces of any size with Push(); the filter state (the last \f$2RK\f$ input samples) is carried from one call to the next.
+ * Input samples before the start and after the end of the stream are taken to be 0: call Flush() at the end of the stream to compute the last output samples.
+ * For \f$N\f$ input samples, \f$\lceil N/R \rceil\f$ output samples are produced.
+ */
+class Odecimator{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Odecimator class.
+   * @details The filter is designed and the stream is reset.
+   * @param[in] aRatio Decimation factor \f$R\f$: must be strictly positive.
+   * @param[in] aHalfLength Filter half length in number of output samples \f$K\f$: a value of 0 is replaced by 1.
+   * @param[in] aCutoff Cutoff frequency, relative to the output Nyquist frequency.
+   * @param[in] aBeta Kaiser window parameter \f$\beta\f$.
+   */
+  Odecimator(const unsigned int aRatio, const unsigned int aHalfLength=16,
+             const double aCutoff=0.9, const double aBeta=8.0);
+
+  /**
+   * @brief Destructor of the Odecimator class.
+   */
+  virtual ~Odecimator(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the decimation factor.
+   */
+  inline unsigned int GetRatio(void){ return ratio; };
+
+  /**
+   * @brief Returns the filter length.
+   */
+  inline unsigned int GetLength(void){ return length; };
+
+  /**
+   * @brief Returns the filter half length in number of output samples \f$K\f$.
+   */
+  inline unsigned int GetHalfLength(void){ return half/ratio; };
+
+  /**
+   * @brief Resets the stream.
+   * @details The filter state is set to 0.
+   */
+  void Reset(void);
+
+  /**
+   * @brief Pushes input samples in the stream.
+   * @returns The number of output samples written in the output vector.
+   * @param[in] aN Number of input samples.
+   * @param[in] aIn Input samples.
+   * @param[out] aOut Output vector. It must be allocated with at least \f$\lfloor aN/R \rfloor + 1\f$ values.
+   */
+  unsigned int Push(const unsigned int aN, const double *aIn, double *aOut);
+
+  /**
+   * @brief Ends the stream.
+   * @details The remaining output samples are computed, with 0 for the input samples after the end of the stream.
+   * Then the stream is reset.
+   * @returns The number of output samples written in the output vector.
+   * @param[out] aOut Output vector. It must be allocated with at least \f$K+1\f$ values.
+   */
+  unsigned int Flush(double *aOut);
+
+ private:
+
+  unsigned int ratio;   ///< Decimation factor \f$R\f$.
+  unsigned int half;    ///< Filter half length \f$RK\f$.
+  unsigned int length;  ///< Filter length \f$L\f$.
+  double *h;            ///< Filter coefficients (symmetric).
+  double *buffer;       ///< Input buffer: filter state followed by new samples.
+  unsigned int nbuf;    ///< Number of samples in the buffer.
+  unsigned int next;    ///< Buffer index of the next output sample center.
+  long unsigned int n_in; ///< Number of input samples in the stream.
+  long unsigned int n_out;///< Number of output samples in the stream.
+
+  /**
+   * @brief Computes the output samples available in the buffer.
+   * @details The buffer is then shifted to only keep the filter state.
+   * @returns The number of output samples.
+   * @param[out] aOut Output vector.
+   * @param[in] aInN Number of input samples in the stream: output samples are not computed beyond.
+   */
+  unsigned int Decimate(double *aOut, const long unsigned int aInN);
+
+  /**
+   * @brief Modified Bessel function of the first kind, order 0.
+   * @param[in] aX Argument.
+   */
+  static double BesselI0(const double aX);
+
+};
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file 
+ * @brief Omicron binary index of frame file lists.
+ */
+#ifndef __Offl__
+#define __Offl__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Binary index of a frame file list (FFL or LCF).
+ * @details This class is designed to speed up the loading of large frame file lists.
+ * The frame file list is parsed once and a binary index is written in a sidecar file, next to the frame file list (`[FFL].oidx` by default): see Build().
+ * The index file contains:
+ * - a header with the size and the modification time of the frame file list,
+ * - the list of frames sorted by GPS time: GPS start time, duration and offset of the file path in the string table,
+ * - the channel table: channel names and sampling frequencies,
+ * - the string table (file paths and channel names).
+ *
+ * When an Offl object is constructed, the index file is memory-mapped (read-only) and nothing is parsed.
+ * The index is considered invalid if the size or the modification time of the frame file list changed, or if the index file is corrupted: see IsValid().
+ * An index file is corrupted if its section sizes do not add up to the file size, if a string offset points outside the string table, or if the string table does not end with a null character.
+ * The frames are searched with a binary search by GPS time.
+ * The frames are expected not to overlap in time, except for frames with the same start time (e.g. the same data in two directories).
+ *
+ * The FFL format is one frame per line: file path, GPS start time, duration, and two unused fields. Non-numerical fields after the file path are ignored.
+ * Duplicated frames (same path, start time and duration) are only indexed once.
+ * The LCF format is also supported: one frame per line with the fields observatory, frame type, GPS start time, duration and file URL (file:// prefix removed).
+ */
+class Offl{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Offl class.
+   * @details The index file is memory-mapped and checked against the frame file list.
+   * @param[in] aFflFile Path to the frame file list.
+   * @param[in] aIndexFile Path to the index file. Use "" for the default path.
+   */
+  Offl(const string aFflFile, const string aIndexFile="");
+
+  /**
+   * @brief Destructor of the Offl class.
+   * @details The index file is unmapped.
+   */
+  virtual ~Offl(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Writes the index file of a frame file list.
+   * @details The frame file list is parsed and the frames are sorted by GPS time.
+   * The channel table is given by the user, typically after extracting the channels from the first frame (this is the expensive part of the frame file list loading).
+   * The index is written in a temporary file which is then renamed: concurrent processes can safely build the same index.
+   * @returns false if the frame file list cannot be read or if the index file cannot be written.
+   * @param[in] aFflFile Path to the frame file list.
+   * @param[in] aChannels List of channel names.
+   * @param[in] aSampling List of channel sampling frequencies [Hz]: same size as the list of channels.
+   * @param[in] aIndexFile Path to the index file. Use "" for the default path.
+   */
+  static bool Build(const string aFflFile, const vector<string> &aChannels,
+                    const vector<unsigned int> &aSampling, const string aIndexFile="");
+
+  /**
+   * @brief Returns true if the index is valid.
+   * @details The index is valid if the index file exists, is consistent and matches the frame file list.
+   */
+  inline bool IsValid(void){ return header!=NULL; };
+
+  /**
+   * @brief Returns the number of frames.
+   */
+  inline unsigned int GetFrameN(void){ return header==NULL ? 0 : header->frame_n; };
+
+  /**
+   * @brief Returns the GPS start time of a frame [s].
+   * @param[in] aFrameIndex Frame index: must be valid.
+   */
+  inline double GetFrameStart(const unsigned int aFrameIndex){ return frames[aFrameIndex].start; };
+
+  /**
+   * @brief Returns the duration of a frame [s].
+   * @param[in] aFrameIndex Frame index: must be valid.
+   */
+  inline double GetFrameDuration(const unsigned int aFrameIndex){ return frames[aFrameIndex].duration; };
+
+  /**
+   * @brief Returns the file path of a frame.
+   * @param[in] aFrameIndex Frame index: must be valid.
+   */
+  inline string GetFramePath(const unsigned int aFrameIndex){ return string(strings+frames[aFrameIndex].path); };
+
+  /**
+   * @brief Returns the index of the frame containing a GPS time.
+   * @details The frames are searched with a binary search.
+   * @returns -1 if no frame contains the GPS time.
+   * @param[in] aGps GPS time [s].
+   */
+  int FindFrame(const double aGps);
+
+  /**
+   * @brief Returns the range of frames overlapping a time range.
+   * @details The frames with an index from aFirst (included) to aLast (excluded) overlap the time range.
+   * @returns false if no frame overlaps the time range.
+   * @param[in] aTimeStart GPS start time [s].
+   * @param[in] aTimeEnd GPS end time [s].
+   * @param[out] aFirst Index of the first frame.
+   * @param[out] aLast Index of the last frame + 1.
+   */
+  bool GetFrames(const double aTimeStart, const double aTimeEnd,
+                 unsigned int &aFirst, unsigned int &aLast);
+
+  /**
+   * @brief Returns the number of channels.
+   */
+  inline unsigned int GetChannelN(void){ return header==NULL ? 0 : header->channel_n; };
+
+  /**
+   * @brief Returns the name of a channel.
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline string GetChannelName(const unsigned int aChannelIndex){ return string(strings+chans[aChannelIndex].name); };
+
+  /**
+   * @brief Returns the sampling frequency of a channel [Hz].
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline unsigned int GetChannelSampling(const unsigned int aChannelIndex){ return chans[aChannelIndex].sampling; };
+
+ private:
+
+  /**
+   * @brief Index file header.
+   */
+  struct Header{
+    char magic[8];                  ///< Magic string "OFFLIDX".
+    uint32_t version;               ///< Format version.
+    uint32_t channel_n;             ///< Number of channels.
+    long unsigned int ffl_size;     ///< Size of the frame file list [bytes].
+    long unsigned int ffl_mtime;    ///< Modification time of the frame file list [ns].
+    long unsigned int frame_n;      ///< Number of frames.
+    long unsigned int string_size;  ///< Size of the string table [bytes].
+  };
+
+  /**
+   * @brief Index file frame record.
+   */
+  struct Frame{
+    double start;                   ///< GPS start time [s].
+    double duration;                ///< Duration [s].
+    long unsigned int path;         ///< File path offset in the string table.
+  };
+
+  /**
+   * @brief Index file channel record.
+   */
+  struct Channel{
+    long unsigned int name;         ///< Channel name offset in the string table.
+    long unsigned int sampling;     ///< Sampling frequency [Hz].
+  };
+
+  void *map;                        ///< Mapped index file.
+  long unsigned int map_size;       ///< Mapped size [bytes].
+  const Header *header;             ///< Header (NULL if the index is invalid).
+  const Frame *frames;              ///< Frame records.
+  const Channel *chans;             ///< Channel records.
+  const char *strings;              ///< String table.
+
+  /**
+   * @brief Returns the index of the first frame starting after a GPS time.
+   * @param[in] aGps GPS time [s].
+   */
+  unsigned int UpperBound(const double aGps);
+
+  /**
+   * @brief Returns the size and modification time of a file.
+   * @returns false if the file does not exist.
+   * @param[in] aFile File path.
+   * @param[out] aSize File size [bytes].
+   * @param[out] aMtime Modification time [ns].
+   */
+  static bool GetFileStat(const string aFile, long unsigned int &aSize, long unsigned int &aMtime);
+
+};
+
+#endif
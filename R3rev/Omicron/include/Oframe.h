@@ -0,0 +1,123 @@
+/**
+ * @file 
+ * @brief Omicron multi-channel frame reader.
+ */
+#ifndef __Oframe__
+#define __Oframe__
+
+#include "Ogwf.h"
+
+using namespace std;
+
+/**
+ * @brief Reader of several channels in one pass over the frame files.
+ * @details This class is designed to load the data of many channels stored in the same frame files, for a time chunk.
+ * With one loader per channel, every frame file is opened, indexed and decoded once per channel.
+ * With this class, the frame files of the chunk are read one after the other: each frame file is memory-mapped and indexed once (see Ogwf), and the data vectors of all the requested channels are decoded before moving to the next file.
+ *
+ * The data of each channel are decoded in a buffer in their native type, without conversion (see OgwfType): the buffer can be given directly to the conditioning (see Ocondition::Process()).
+ * The native type and the sampling frequency of a channel are given by the first frame file containing the channel.
+ * The samples which are not covered by the frame files are set to 0: see GetLoadedN().
+ *
+ * The frame files given to Load() should all overlap the time chunk (see Offl::GetFrames()): the files are indexed before their time range is known.
+ */
+class Oframe{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Oframe class.
+   * @param[in] aChannels List of channel names.
+   * @param[in] aVerbosity Verbosity level.
+   */
+  Oframe(const vector<string> &aChannels, const unsigned int aVerbosity=0);
+
+  /**
+   * @brief Destructor of the Oframe class.
+   */
+  virtual ~Oframe(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Loads the data of all the channels for a time chunk.
+   * @details The previous data are discarded. Each frame file is read once.
+   * @returns The number of frame files which could be read.
+   * @param[in] aFiles List of frame files.
+   * @param[in] aGpsStart GPS start time of the chunk [s].
+   * @param[in] aGpsEnd GPS end time of the chunk [s].
+   */
+  unsigned int Load(const vector<string> &aFiles, const double aGpsStart, const double aGpsEnd);
+
+  /**
+   * @brief Returns the number of channels.
+   */
+  inline unsigned int GetChannelN(void){ return chans.size(); };
+
+  /**
+   * @brief Returns the name of a channel.
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline string GetChannelName(const unsigned int aChannelIndex){ return chans[aChannelIndex].name; };
+
+  /**
+   * @brief Returns the native type of a channel.
+   * @details ogwf_type_unknown is returned if the channel was not found in the frame files.
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline OgwfType GetType(const unsigned int aChannelIndex){ return chans[aChannelIndex].type; };
+
+  /**
+   * @brief Returns the sampling frequency of a channel [Hz].
+   * @details 0 is returned if the channel was not found in the frame files.
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline double GetSamplingFrequency(const unsigned int aChannelIndex){ return chans[aChannelIndex].fs; };
+
+  /**
+   * @brief Returns the number of samples in the buffer of a channel.
+   * @details This is the chunk duration times the sampling frequency.
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline long unsigned int GetSampleN(const unsigned int aChannelIndex){ return chans[aChannelIndex].n; };
+
+  /**
+   * @brief Returns the number of samples decoded from the frame files for a channel.
+   * @details If this number is smaller than GetSampleN(), the chunk is not fully covered by the frame files.
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline long unsigned int GetLoadedN(const unsigned int aChannelIndex){ return chans[aChannelIndex].loaded; };
+
+  /**
+   * @brief Returns the buffer of a channel.
+   * @details The buffer contains GetSampleN() samples of type GetType(). The first sample corresponds to the start of the chunk.
+   * The buffer is valid until the next call to Load().
+   * @param[in] aChannelIndex Channel index: must be valid.
+   */
+  inline const void* GetData(const unsigned int aChannelIndex){ return chans[aChannelIndex].data.data(); };
+
+ private:
+
+  /**
+   * @brief Channel data.
+   */
+  struct Channel{
+    string name;                    ///< Channel name.
+    OgwfType type;                  ///< Native type.
+    double fs;                      ///< Sampling frequency [Hz].
+    long unsigned int n;            ///< Number of samples in the buffer.
+    long unsigned int loaded;       ///< Number of decoded samples.
+    vector<char> data;              ///< Buffer (native type).
+  };
+
+  unsigned int fVerbosity;          ///< Verbosity level.
+  vector<Channel> chans;            ///< Channels.
+
+};
+
+#endif
@@ -0,0 +1,285 @@
+/**
+ * @file
+ * @brief Omicron memory-mapped frame file reader.
+ */
+#ifndef __Ogwf__
+#define __Ogwf__
+
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+/**
+ * @brief Native data types of frame vectors.
+ * @details The values are the FrVect type codes.
+ */
+enum OgwfType{
+  ogwf_type_int16 = 1,          ///< 16-bit signed integer (INT_2S).
+  ogwf_type_real8 = 2,          ///< Double precision (REAL_8).
+  ogwf_type_real4 = 3,          ///< Single precision (REAL_4).
+  ogwf_type_int32 = 4,          ///< 32-bit signed integer (INT_4S).
+  ogwf_type_unknown = 255       ///< Unsupported type.
+};
+
+/**
+ * @brief Memory-mapped reader of frame files (GWF).
+ * @details This class is designed to read channel data from a frame file without intermediate copies.
+ * The frame file is memory-mapped (read-only) and indexed once, when the object is constructed:
+ * - The dictionary structures (FrSH, FrSE) are parsed to learn the layout of the other structures. This makes the reader independent of the frame format version.
+ * - Only the headers of the FrameH, FrAdcData, FrProcData, FrSimData and FrVect structures are parsed: the data arrays are not touched.
+ * - The data vector of each channel is identified with the `data` pointer of the channel structure. Its GPS start time is given by the frame time, the channel time offset and the vector start value.
+ *
+ * The data is then decoded with Read() straight into a buffer owned by the caller, in the native type of the vector (see OgwfType).
+ * Only the requested samples are decoded: uncompressed vectors are copied from the mapped file and gzip-compressed vectors are inflated until the last requested sample.
+ * The samples are not converted: see Ocondition::Process().
+ *
+ * Limitations:
+ * - The file byte order must be the byte order of the machine.
+ * - Only uncompressed and gzip-compressed vectors are supported. Other compression schemes (differential, zero-suppression) are rejected by Read().
+ * - Only the first vector of a channel is read (the `next` vectors are ignored).
+ *
+ * In case of failure, the caller is expected to fall back to the standard frame library.
+ *
+ * Once the object is constructed, the index and the mapping are only read: the data can be decoded by several threads at the same time (see Ocache).
+ */
+class Ogwf{
+
+ public:
+
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Ogwf class.
+   * @details The frame file is memory-mapped and indexed.
+   * @param[in] aFilePath Path to the frame file.
+   * @param[in] aVerbosity Verbosity level.
+   */
+  Ogwf(const string aFilePath, const unsigned int aVerbosity=0);
+
+  /**
+   * @brief Destructor of the Ogwf class.
+   */
+  virtual ~Ogwf(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the status of the object.
+   * @details false is returned if the file cannot be mapped or if the file format is not supported.
+   */
+  inline bool GetStatus(void){ return status; };
+
+  /**
+   * @brief Returns the frame file path.
+   */
+  inline string GetFilePath(void){ return filepath; };
+
+  /**
+   * @brief Returns the number of indexed data vectors.
+   */
+  inline unsigned int GetVectorN(void){ return vects.size(); };
+
+  /**
+   * @brief Returns the size of a native type [bytes].
+   * @details 0 is returned for an unknown type.
+   * @param[in] aType Native type.
+   */
+  static unsigned int GetTypeSize(const OgwfType aType);
+
+  /**
+   * @brief Returns the native type and the sampling frequency of a channel.
+   * @returns false if the channel is not found in this file.
+   * @param[in] aChannelName Channel name.
+   * @param[out] aType Native type.
+   * @param[out] aSamplingFrequency Sampling frequency [Hz].
+   */
+  bool GetChannel(const string aChannelName, OgwfType &aType, double &aSamplingFrequency);
+
+  /**
+   * @brief Reads the data of a channel in a native buffer.
+   * @details The data vectors of the channel overlapping the requested time range are decoded in the buffer, without type conversion.
+   * The first sample of the buffer corresponds to the GPS time aGpsStart.
+   * Only the part of the time range covered by this file is written: the rest of the buffer is not modified.
+   * This way, the same buffer can be filled with several frame files.
+   * @returns The number of samples written in the buffer. 0 is returned if the channel is not found, if the native type or the sampling frequency do not match, or if the compression scheme is not supported.
+   * @param[in] aChannelName Channel name.
+   * @param[in] aGpsStart GPS time of the first sample of the buffer [s].
+   * @param[in] aSize Number of samples in the buffer.
+   * @param[out] aBuffer Buffer of aSize samples of native type aType, allocated by the caller.
+   * @param[in] aType Native type of the buffer: see GetChannel().
+   * @param[in] aSamplingFrequency Sampling frequency [Hz]: see GetChannel().
+   */
+  long unsigned int Read(const string aChannelName, const double aGpsStart,
+                         const long unsigned int aSize, void *aBuffer,
+                         const OgwfType aType, const double aSamplingFrequency);
+
+  /**
+   * @brief Lists the data vectors of a channel overlapping a time range.
+   * @returns The number of vectors.
+   * @param[in] aChannelName Channel name.
+   * @param[in] aGpsStart GPS start time [s].
+   * @param[in] aGpsEnd GPS end time [s].
+   * @param[out] aVectors Vector indices, in time order.
+   */
+  unsigned int GetVectors(const string aChannelName, const double aGpsStart, const double aGpsEnd,
+                          vector<unsigned int> &aVectors);
+
+  /**
+   * @brief Returns the GPS time of the first sample of a data vector [s].
+   * @param[in] aVectorIndex Vector index: must be valid.
+   */
+  inline double GetVectorStart(const unsigned int aVectorIndex){ return vects[aVectorIndex].start; };
+
+  /**
+   * @brief Returns the number of samples of a data vector.
+   * @param[in] aVectorIndex Vector index: must be valid.
+   */
+  inline long unsigned int GetVectorSampleN(const unsigned int aVectorIndex){ return vects[aVectorIndex].ndata; };
+
+  /**
+   * @brief Returns the native type of a data vector.
+   * @param[in] aVectorIndex Vector index: must be valid.
+   */
+  inline OgwfType GetVectorType(const unsigned int aVectorIndex){ return vects[aVectorIndex].type; };
+
+  /**
+   * @brief Returns the sampling frequency of a data vector [Hz].
+   * @param[in] aVectorIndex Vector index: must be valid.
+   */
+  inline double GetVectorSamplingFrequency(const unsigned int aVectorIndex){ return 1.0/vects[aVectorIndex].dx; };
+
+  /**
+   * @brief Decodes a full data vector.
+   * @details This function can be called by several threads at the same time.
+   * @returns false if the native type or the compression scheme is not supported.
+   * @param[in] aVectorIndex Vector index: must be valid.
+   * @param[out] aOut Output buffer of GetVectorSampleN() samples of type GetVectorType(), allocated by the caller.
+   */
+  bool DecodeVector(const unsigned int aVectorIndex, void *aOut);
+
+ private:
+
+  /**
+   * @brief Data vector record.
+   */
+  struct Vect{
+    string name;                    ///< Channel name.
+    double start;                   ///< GPS time of the first sample [s].
+    double dx;                      ///< Sampling period [s].
+    long unsigned int ndata;        ///< Number of samples.
+    unsigned short compress;        ///< Compression scheme.
+    OgwfType type;                  ///< Native type.
+    long unsigned int offset;       ///< Offset of the data array in the file [bytes].
+    long unsigned int nbytes;       ///< Size of the data array [bytes].
+  };
+
+  /**
+   * @brief Dictionary element.
+   */
+  struct Element{
+    string name;                    ///< Element name.
+    int kind;                       ///< 0 = number, 1 = string, 2 = pointer, 3 = number array, 4 = string array.
+    unsigned int size;              ///< Size of a number [bytes].
+    bool real;                      ///< The number is a floating-point number.
+    bool sign;                      ///< The number is a signed integer.
+    string count;                   ///< Array size: element name or number.
+  };
+
+  /**
+   * @brief Parsed structure values.
+   */
+  struct Values{
+    string name;                    ///< First string element called "name".
+    std::map<string, double> num;   ///< Numbers (first value for arrays).
+    std::map<string, unsigned int> ptr;   ///< Pointer instances.
+    std::map<string, long unsigned int> arr; ///< Array offsets in the file [bytes].
+  };
+
+  static const unsigned int header_size = 40;   ///< File header size [bytes].
+  static const unsigned int struct_size = 14;   ///< Structure header size [bytes].
+
+  unsigned int fVerbosity;          ///< Verbosity level.
+  string filepath;                  ///< Frame file path.
+  bool status;                      ///< Status of the object.
+  const char *map;                  ///< Mapped file.
+  long unsigned int map_size;       ///< Mapped size [bytes].
+  vector<Vect> vects;               ///< Data vectors, sorted by channel name and time.
+
+  /**
+   * @brief Orders data vector records by channel name.
+   */
+  static bool VectBefore(const Vect &aV, const string &aName);
+
+  /**
+   * @brief Orders data vector records by channel name and time.
+   */
+  static bool VectLess(const Vect &aV1, const Vect &aV2);
+
+  /**
+   * @brief Reads a number from the mapped file.
+   * @param[in] aOffset Offset [bytes].
+   * @param[in] aElement Number description.
+   */
+  double GetNumber(const long unsigned int aOffset, const Element &aElement);
+
+  /**
+   * @brief Reads a string from the mapped file.
+   * @returns The offset after the string. 0 is returned if the string exceeds the limit.
+   * @param[in] aOffset Offset [bytes].
+   * @param[in] aEnd Offset limit [bytes].
+   * @param[out] aString String.
+   */
+  long unsigned int GetString(const long unsigned int aOffset, const long unsigned int aEnd, string &aString);
+
+  /**
+   * @brief Converts a dictionary type to an element.
+   * @param[in] aName Element name.
+   * @param[in] aType Element type, as written in the FrSE structure.
+   */
+  static Element MakeElement(const string aName, const string aType);
+
+  /**
+   * @brief Parses a structure following the dictionary.
+   * @details The parsing stops at the end of the structure, or at the first element which cannot be parsed (unknown type or array size).
+   * @param[in] aElements Structure elements.
+   * @param[in] aOffset Offset of the structure body [bytes].
+   * @param[in] aEnd Offset of the structure end [bytes].
+   * @param[out] aValues Parsed values.
+   */
+  void Parse(const vector<Element> &aElements, long unsigned int aOffset, const long unsigned int aEnd, Values &aValues);
+
+  /**
+   * @brief Indexes the data vectors of the file.
+   * @returns false if the file format is not supported.
+   */
+  bool MakeIndex(void);
+
+  /**
+   * @brief Adds the data vectors of a frame to the index.
+   * @details Only the vectors pointed by a channel are added. The frame containers are emptied.
+   * @param[in,out] aVects Vectors of the frame.
+   * @param[in,out] aOffsets Channel time offsets of the frame.
+   * @param[in] aFrameTime Frame GPS time [s].
+   */
+  void AddVectors(std::map<unsigned int, Vect> &aVects, std::map<unsigned int, double> &aOffsets, const double aFrameTime);
+
+  /**
+   * @brief Decodes a range of samples of a data vector.
+   * @returns false if the compression scheme is not supported or if the data is corrupted.
+   * @param[in] aVect Data vector.
+   * @param[in] aFirst Index of the first sample to decode.
+   * @param[in] aN Number of samples to decode.
+   * @param[in] aTypeSize Sample size [bytes].
+   * @param[out] aOut Output buffer.
+   */
+  bool Decode(const Vect &aVect, const long unsigned int aFirst, const long unsigned int aN,
+              const unsigned int aTypeSize, char *aOut);
+
+};
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file
+ * @brief Omicron HDF5 strain file reader.
+ */
+#ifndef __Oh5__
+#define __Oh5__
+
+#include "Oconfig.h"
+#include "Ogwf.h"
+#include <hdf5.h>
+
+using namespace std;
+
+/**
+ * @brief Reader of HDF5 strain files (GWOSC format).
+ * @details This class is designed to read the strain data from the HDF5 files distributed by the Gravitational Wave Open Science Center (GWOSC), without converting them to frame files.
+ * The expected layout is:
+ * - `strain/Strain`: one-dimensional dataset with the strain samples,
+ * - `Xstart`: attribute of the dataset with the GPS time of the first sample [s],
+ * - `Xspacing`: attribute of the dataset with the sampling period [s],
+ * - `meta/Detector`: detector prefix, for example "H1" (optional).
+ *
+ * If the `Xstart` attribute is missing, the `meta/GPSstart` dataset is used.
+ *
+ * The file is opened once, when the object is constructed: only the attributes are read.
+ * The samples are read with Read(): a hyperslab selection covering the requested time range is read, so only the dataset chunks overlapping the time range are read and decompressed by the HDF5 library.
+ * The dataset chunk cache is set to O_H5_CHUNK_CACHE bytes to read consecutive time ranges efficiently.
+ * The samples are read in their native type (see OgwfType), as with Ogwf.
+ * Only signed 16-bit and 32-bit integers and 32-bit and 64-bit floating-point numbers are supported: the other types (unsigned integers, other sizes) are marked as ogwf_type_unknown and GetStatus() returns false.
+ *
+ * The HDF5 errors are reported by this class: the automatic printing of the HDF5 error stack is turned off while the file is read, and the caller's error handler is restored afterwards (see ErrorMute).
+ */
+class Oh5{
+
+ public:
+
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Oh5 class.
+   * @details The HDF5 file is opened and the strain dataset attributes are read.
+   * @param[in] aFilePath Path to the HDF5 file.
+   * @param[in] aDataset Path to the strain dataset in the file.
+   * @param[in] aVerbosity Verbosity level.
+   */
+  Oh5(const string aFilePath, const string aDataset="strain/Strain", const unsigned int aVerbosity=0);
+
+  /**
+   * @brief Destructor of the Oh5 class.
+   */
+  virtual ~Oh5(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the status of the object.
+   * @details false is returned if the file cannot be opened or if the strain dataset is not supported.
+   */
+  inline bool GetStatus(void){ return (dset>=0)&&(type!=ogwf_type_unknown)&&(nsamples>0)&&(start>0.0)&&(dx>0.0); };
+
+  /**
+   * @brief Returns the file path.
+   */
+  inline string GetFilePath(void){ return filepath; };
+
+  /**
+   * @brief Returns the detector prefix.
+   * @details "" is returned if the detector is not given in the file.
+   */
+  inline string GetDetector(void){ return detector; };
+
+  /**
+   * @brief Returns the GPS time of the first sample [s].
+   */
+  inline double GetStart(void){ return start; };
+
+  /**
+   * @brief Returns the GPS end time of the data [s].
+   */
+  inline double GetEnd(void){ return start+(double)nsamples*dx; };
+
+  /**
+   * @brief Returns the sampling frequency [Hz].
+   */
+  inline double GetSamplingFrequency(void){ return dx>0.0 ? 1.0/dx : 0.0; };
+
+  /**
+   * @brief Returns the number of samples.
+   */
+  inline long unsigned int GetSampleN(void){ return nsamples; };
+
+  /**
+   * @brief Returns the native type of the samples.
+   */
+  inline OgwfType GetType(void){ return type; };
+
+  /**
+   * @brief Reads the samples in a native buffer.
+   * @details The samples overlapping the requested time range are read with a hyperslab selection, without type conversion.
+   * The first sample of the buffer corresponds to the GPS time aGpsStart.
+   * Only the part of the time range covered by this file is written: the rest of the buffer is not modified.
+   * This way, the same buffer can be filled with several files.
+   * @returns The number of samples written in the buffer. 0 is returned if the native type or the sampling frequency do not match, or if the read fails.
+   * @param[in] aGpsStart GPS time of the first sample of the buffer [s].
+   * @param[in] aSize Number of samples in the buffer.
+   * @param[out] aBuffer Buffer of aSize samples of native type aType, allocated by the caller.
+   * @param[in] aType Native type of the buffer: see GetType().
+   * @param[in] aSamplingFrequency Sampling frequency [Hz]: see GetSamplingFrequency().
+   */
+  long unsigned int Read(const double aGpsStart, const long unsigned int aSize, void *aBuffer,
+                         const OgwfType aType, const double aSamplingFrequency);
+
+ private:
+
+  unsigned int fVerbosity;          ///< Verbosity level.
+  string filepath;                  ///< File path.
+  string detector;                  ///< Detector prefix.
+  hid_t file;                       ///< HDF5 file.
+  hid_t dset;                       ///< Strain dataset.
+  OgwfType type;                    ///< Native type of the samples.
+  double start;                     ///< GPS time of the first sample [s].
+  double dx;                        ///< Sampling period [s].
+  long unsigned int nsamples;       ///< Number of samples.
+
+  /**
+   * @brief Turns off the HDF5 automatic error printing in a scope.
+   * @details The current error handler is saved when the object is constructed and restored when it is destroyed.
+   */
+  class ErrorMute{
+  public:
+    /**
+     * @brief Saves the current error handler and turns off the automatic error printing.
+     */
+    ErrorMute(void);
+    /**
+     * @brief Restores the saved error handler.
+     */
+    ~ErrorMute(void);
+  private:
+    H5E_auto2_t func;               ///< Saved error handler.
+    void *data;                     ///< Saved error handler data.
+  };
+
+  /**
+   * @brief Returns the HDF5 memory type of a native type.
+   * @param[in] aType Native type.
+   */
+  static hid_t GetMemoryType(const OgwfType aType);
+
+  /**
+   * @brief Reads a numerical attribute.
+   * @returns false if the attribute does not exist.
+   * @param[in] aObject HDF5 object.
+   * @param[in] aName Attribute name.
+   * @param[out] aValue Attribute value.
+   */
+  static bool ReadAttribute(const hid_t aObject, const string aName, double &aValue);
+
+  /**
+   * @brief Reads a scalar string dataset.
+   * @details Fixed-length and variable-length strings are supported.
+   * @returns false if the dataset is not a string.
+   * @param[in] aDataset HDF5 dataset.
+   * @param[out] aValue String value.
+   */
+  static bool ReadString(const hid_t aDataset, string &aValue);
+
+};
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @brief Omicron thread pool.
+ */
+#ifndef __Opool__
+#define __Opool__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Pool of worker threads.
+ * @details This class is designed to run a list of independent tasks over a fixed set of worker threads.
+ * The threads are created once, when the pool is constructed, and they are re-used every time Run() is called.
+ *
+ * A list of tasks is identified by a number of tasks \f$N\f$: tasks are indexed from 0 to \f$N-1\f$.
+ * The tasks are distributed dynamically: every thread picks the next task index until the list is exhausted.
+ * The calling thread participates to the work as the thread with index 0.
+ * The task function also receives the index of the thread running it.
+ * It can be used to address per-thread scratch buffers.
+ *
+ * A pool with 1 thread does not create any worker thread: the tasks are run sequentially by the calling thread, in the index order.
+ */
+class Opool{
+
+ public:
+
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Opool class.
+   * @details The worker threads are started.
+   * @param[in] aThreadN Number of threads, including the calling thread. If 0, the number of hardware threads is used.
+   */
+  Opool(const unsigned int aThreadN);
+
+  /**
+   * @brief Destructor of the Opool class.
+   * @details The worker threads are stopped and joined.
+   */
+  virtual ~Opool(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the number of threads.
+   */
+  inline unsigned int GetThreadN(void){ return nthreads; };
+
+  /**
+   * @brief Runs a list of tasks.
+   * @details This function returns when all the tasks are completed.
+   * @warning This function is not re-entrant: a task must not call Run() on the same pool.
+   * @param[in] aTaskN Number of tasks.
+   * @param[in] aTask Task function. The first argument is the task index, the second one is the thread index.
+   */
+  void Run(const unsigned int aTaskN, function<void(const unsigned int, const unsigned int)> aTask);
+
+ private:
+
+  unsigned int nthreads;                 ///< Number of threads.
+  vector<thread> workers;                ///< Worker threads.
+  mutex mtx;                             ///< Pool mutex.
+  condition_variable cv_start;           ///< Signals a new list of tasks.
+  condition_variable cv_done;            ///< Signals the end of a list of tasks.
+  function<void(const unsigned int, const unsigned int)> task; ///< Current task function.
+  unsigned int task_n;                   ///< Number of tasks in the current list.
+  atomic<unsigned int> task_next;        ///< Next task index to run.
+  unsigned int task_done;                ///< Number of completed tasks.
+  unsigned int active;                   ///< Number of workers inside the current list.
+  unsigned long int generation;          ///< Task list counter.
+  bool stop;                             ///< Flag to stop the workers.
+
+  /**
+   * @brief Runs tasks until the current list is exhausted.
+   * @param[in] aThreadIndex Thread index.
+   */
+  void RunTasks(const unsigned int aThreadIndex);
+
+  /**
+   * @brief Worker thread loop.
+   * @param[in] aThreadIndex Thread index.
+   */
+  void Work(const unsigned int aThreadIndex);
+
+};
+
+#endif
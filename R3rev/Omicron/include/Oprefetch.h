@@ -0,0 +1,141 @@
+/**
+ * @file 
+ * @brief Omicron data read-ahead.
+ */
+#ifndef __Oprefetch__
+#define __Oprefetch__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Data loader function.
+ * @details The function loads the data of one channel for a time chunk.
+ * It returns false if the data cannot be loaded.
+ * Arguments: GPS start time, GPS end time, channel index, pointer to the data vector (allocated by the function with new[]), data vector size.
+ */
+typedef function<bool(const unsigned int, const unsigned int, const unsigned int, double**, unsigned int&)> OprefetchLoader;
+
+/**
+ * @brief Load data ahead in a background thread.
+ * @details This class is designed to overlap the data loading with the data processing.
+ * When a chunk is being processed, the data of the next chunk are requested with Request(): they are loaded in a background thread, for all the requested channels.
+ * The data are then collected with Get().
+ *
+ * The memory used by the loaded data is bounded: the background thread stops loading when the loaded (and not collected) data exceed a memory budget.
+ * It resumes when data are collected.
+ *
+ * Pending requests and loaded data can be discarded at any time with Cancel(), for example at the end of a segment.
+ * A data vector being loaded when Cancel() is called is discarded when the loader function returns.
+ *
+ * The loader function is only called from the background thread: it must not share non-thread-safe objects with the processing thread.
+ * For example, it should use its own ffl object.
+ */
+class Oprefetch{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Oprefetch class.
+   * @details The background thread is started.
+   * @param[in] aLoader Data loader function.
+   * @param[in] aMemoryBudget Memory budget [bytes].
+   */
+  Oprefetch(OprefetchLoader aLoader, const long unsigned int aMemoryBudget);
+
+  /**
+   * @brief Destructor of the Oprefetch class.
+   * @details The background thread is stopped and the loaded data are deleted.
+   */
+  virtual ~Oprefetch(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Requests the data of a time chunk.
+   * @details The request is queued: the data are loaded in the background thread, in the order of the channel list.
+   * @param[in] aTimeStart GPS start time.
+   * @param[in] aTimeEnd GPS end time.
+   * @param[in] aChannels List of channel indices.
+   */
+  void Request(const unsigned int aTimeStart, const unsigned int aTimeEnd,
+               const vector<unsigned int> &aChannels);
+
+  /**
+   * @brief Collects the data of a channel for a time chunk.
+   * @details If the data were requested, this function waits until they are loaded.
+   * The ownership of the data vector is transferred to the caller.
+   * @returns false if the data were not requested (or were canceled), or if the loader failed. In this case, the data vector points to NULL.
+   * @param[in] aTimeStart GPS start time.
+   * @param[in] aTimeEnd GPS end time.
+   * @param[in] aChannel Channel index.
+   * @param[out] aData Pointer to the data vector. It must be deleted by the caller (delete []).
+   * @param[out] aSize Data vector size.
+   */
+  bool Get(const unsigned int aTimeStart, const unsigned int aTimeEnd, const unsigned int aChannel,
+           double **aData, unsigned int &aSize);
+
+  /**
+   * @brief Cancels all the requests.
+   * @details The pending requests are removed and the loaded data are deleted.
+   */
+  void Cancel(void);
+
+  /**
+   * @brief Returns the memory used by the loaded data [bytes].
+   */
+  inline long unsigned int GetMemoryUsed(void){
+    lock_guard<mutex> lock(mtx);
+    return used;
+  };
+
+ private:
+
+  typedef tuple<unsigned int, unsigned int, unsigned int> Key;///< Request: GPS start, GPS end, channel index.
+  typedef pair<double*, unsigned int> Vect;                   ///< Data vector and size.
+
+  OprefetchLoader loader;       ///< Data loader function.
+  long unsigned int budget;     ///< Memory budget [bytes].
+  long unsigned int used;       ///< Memory used by the loaded data [bytes].
+  deque<Key> pending;           ///< Pending requests.
+  map<Key, Vect> data;          ///< Loaded data.
+  Key current;                  ///< Request being loaded.
+  bool busy;                    ///< Flag: a request is being loaded.
+  long unsigned int generation; ///< Cancellation counter.
+  bool stop;                    ///< Flag to stop the background thread.
+  mutex mtx;                    ///< Mutex.
+  condition_variable cv;        ///< Condition variable.
+  thread worker;                ///< Background thread.
+
+  /**
+   * @brief Returns true if a request is pending.
+   * @param[in] aKey Request.
+   */
+  bool IsPending(const Key &aKey);
+
+  /**
+   * @brief Deletes the loaded data.
+   */
+  void Clear(void);
+
+  /**
+   * @brief Background thread loop.
+   */
+  void Work(void);
+
+};
+
+#endif
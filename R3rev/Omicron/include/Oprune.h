@@ -0,0 +1,97 @@
+/**
+ * @file 
+ * @brief Omicron pruned inverse Fourier transform.
+ */
+#ifndef __Oprune__
+#define __Oprune__
+
+#include <fftw3.h>
+
+using namespace std;
+
+/**
+ * @brief Inverse Fourier transform computing a time range only.
+ * @details This class is designed to compute a subset of the output samples of an inverse Fourier transform, for instance the time tiles of a band which are outside the padding region of a time chunk.
+ *
+ * The transform size is \f$N = LM\f$, where \f$M\f$ is the number of output blocks and \f$L\f$ is the block size.
+ * With \f$k = Mk_1 + k_2\f$ and \f$n = n_1 + Ln_2\f$, the inverse transform \f$y_n = \sum_k x_k e^{2i\pi kn/N}\f$ is decomposed in two stages:
+ * - \f$M\f$ inverse transforms of size \f$L\f$, over the input samples taken with a stride \f$M\f$: \f$a_{k_2,n_1} = \sum_{k_1} x_{Mk_1+k_2} e^{2i\pi k_1n_1/L}\f$. They are computed with a single fftw plan.
+ * - For each requested output sample: \f$y_n = \sum_{k_2} a_{k_2,n_1} e^{2i\pi k_2n/N}\f$. The twiddle factors are tabulated.
+ *
+ * The first stage costs \f$O(N\log L)\f$ and is always computed. The second stage costs \f$M\f$ complex products per output sample.
+ * Computing \f$K\f$ output samples therefore costs about \f$N\log_2 L + KM\f$ operations, against \f$N\log_2 N\f$ for the full transform:
+ * the pruned transform is only faster when the fraction of requested samples is lower than \f$\log_2(M)/M\f$.
+ * For example, with \f$M=4\f$, at most half of the output samples should be requested.
+ *
+ * The fftw planner is not thread-safe: Oprune objects must be constructed and destroyed by one thread at a time.
+ */
+class Oprune{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Oprune class.
+   * @param[in] aSize Transform size \f$N\f$.
+   * @param[in] aBlockN Number of output blocks \f$M\f$: it must divide the transform size.
+   */
+  Oprune(const unsigned int aSize, const unsigned int aBlockN);
+
+  /**
+   * @brief Destructor of the Oprune class.
+   */
+  virtual ~Oprune(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the status of the object.
+   * @details false is returned if the number of blocks does not divide the transform size.
+   */
+  inline bool GetStatus(void){ return plan!=NULL; };
+
+  /**
+   * @brief Returns the transform size \f$N\f$.
+   */
+  inline unsigned int GetSize(void){ return size; };
+
+  /**
+   * @brief Returns the number of output blocks \f$M\f$.
+   */
+  inline unsigned int GetBlockN(void){ return blockn; };
+
+  /**
+   * @brief Returns the number of output samples in a block \f$L\f$.
+   */
+  inline unsigned int GetBlockSize(void){ return blocksize; };
+
+  /**
+   * @brief Computes the output samples of a range of blocks.
+   * @details The output samples \f$y_n\f$ are computed for \f$n\f$ from \f$L\times\f$ aFirstBlock (included) to \f$L\times\f$ aLastBlock (excluded).
+   * The transform is not normalized.
+   * @returns false if the block range is not valid.
+   * @param[in] aIn Input vector \f$x\f$: \f$N\f$ complex samples.
+   * @param[in] aFirstBlock Index of the first output block.
+   * @param[in] aLastBlock Index of the last output block + 1.
+   * @param[out] aOut Output samples: \f$L\times\f$(aLastBlock-aFirstBlock) complex samples. The first sample is \f$y_{L\times aFirstBlock}\f$.
+   */
+  bool Transform(const fftw_complex *aIn, const unsigned int aFirstBlock, const unsigned int aLastBlock,
+                 fftw_complex *aOut);
+
+ private:
+
+  unsigned int size;        ///< Transform size \f$N\f$.
+  unsigned int blockn;      ///< Number of output blocks \f$M\f$.
+  unsigned int blocksize;   ///< Block size \f$L\f$.
+  fftw_complex *in;         ///< Input samples.
+  fftw_complex *stage;      ///< First-stage transforms \f$a_{k_2,n_1}\f$ (one row per \f$k_2\f$).
+  double *twiddle;          ///< Twiddle factors \f$e^{2i\pi j/N}\f$ (interleaved).
+  fftw_plan plan;           ///< First-stage plan.
+
+};
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @file 
+ * @brief Omicron running-median power spectral density.
+ */
+#ifndef __Opsd__
+#define __Opsd__
+
+#include "Oconfig.h"
+#include <TMath.h>
+#include <fftw3.h>
+#include <set>
+
+using namespace std;
+
+/**
+ * @brief Running median of a stream of values.
+ * @details This class is designed to maintain the median of the last \f$W\f$ values of a stream.
+ * The values are split in two sorted halves (two multisets): the lower half and the upper half, with the lower half holding the extra value if the number of values is odd.
+ * Adding a value and removing the oldest value costs \f$O(\log W)\f$.
+ * The values are also saved in a ring buffer to identify the oldest one.
+ */
+class Omedian{
+
+ public:
+
+  /**
+   * @brief Constructor of the Omedian class.
+   * @param[in] aWindowN Number of values in the window \f$W\f$: must be strictly positive.
+   */
+  Omedian(const unsigned int aWindowN=1);
+
+  /**
+   * @brief Destructor of the Omedian class.
+   */
+  virtual ~Omedian(void);
+
+  /**
+   * @brief Sets the window size and resets the stream.
+   * @param[in] aWindowN Number of values in the window \f$W\f$: must be strictly positive.
+   */
+  void SetWindowN(const unsigned int aWindowN);
+
+  /**
+   * @brief Resets the stream.
+   */
+  void Reset(void);
+
+  /**
+   * @brief Returns the number of values in the window.
+   */
+  inline unsigned int GetN(void){ return n; };
+
+  /**
+   * @brief Adds a value to the stream.
+   * @details If the window is full, the oldest value is removed.
+   * @param[in] aValue New value.
+   */
+  void Add(const double aValue);
+
+  /**
+   * @brief Returns the median of the values in the window.
+   * @details For an even number of values, the mean of the 2 central values is returned.
+   * @pre There must be at least one value in the window.
+   */
+  double GetMedian(void);
+
+ private:
+
+  multiset<double> lo;      ///< Lower half.
+  multiset<double> hi;      ///< Upper half.
+  vector<double> ring;      ///< Values in the window, in order of arrival.
+  unsigned int ring_next;   ///< Ring index of the next value.
+  unsigned int n;           ///< Number of values in the window.
+
+};
+
+/**
+ * @brief Incremental power spectral density estimation.
+ * @details This class is designed to estimate the one-sided power spectral density (PSD) of a data stream with a running median.
+ * The data is divided in segments of \f$N\f$ samples, overlapping by 50%.
+ * Each segment is multiplied by a Hann window and Fourier-transformed to compute a periodogram.
+ * The PSD is the median of the last \f$W\f$ periodograms, independently for each frequency bin, corrected for the median bias.
+ *
+ * Each frequency bin is a running median (see Omedian): adding a periodogram and removing the oldest one costs \f$O(N \log W)\f$.
+ * The PSD estimate is never re-computed from scratch.
+ *
+ * The segment fft plan is created with `FFTW_ESTIMATE`: constructing an Opsd object does not time any transform.
+ * As the fftw planner is not thread-safe, the Opsd objects must be constructed and destroyed in one thread at a time (for example, before the worker threads start).
+ * Calls to AddData() on different Opsd objects can then run concurrently.
+ */
+class Opsd{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Opsd class.
+   * @param[in] aSamplingFrequency Sampling frequency [Hz].
+   * @param[in] aSegmentSize Number of samples in a segment \f$N\f$: must be even. The frequency resolution is the sampling frequency divided by \f$N\f$.
+   * @param[in] aWindowN Number of periodograms in the running median \f$W\f$.
+   */
+  Opsd(const unsigned int aSamplingFrequency, const unsigned int aSegmentSize, const unsigned int aWindowN);
+
+  /**
+   * @brief Destructor of the Opsd class.
+   */
+  virtual ~Opsd(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Resets the PSD estimate.
+   */
+  void Reset(void);
+
+  /**
+   * @brief Adds a data vector.
+   * @details The data vector is divided in segments overlapping by 50%: a periodogram is added for each segment.
+   * The last samples of the vector, not filling a segment, are ignored.
+   * @returns The number of periodograms added.
+   * @param[in] aN Number of samples.
+   * @param[in] aData Data vector.
+   */
+  unsigned int AddData(const unsigned int aN, const double *aData);
+
+  /**
+   * @brief Adds a periodogram.
+   * @details If the running median is full, the oldest periodogram is removed.
+   * @param[in] aPeriodogram One-sided periodogram [Hz\f$^{-1}\f$]: GetBinN() values.
+   */
+  void AddPeriodogram(const double *aPeriodogram);
+
+  /**
+   * @brief Returns the number of periodograms in the running median.
+   */
+  inline unsigned int GetPeriodogramN(void){ return median[0].GetN(); };
+
+  /**
+   * @brief Returns the number of frequency bins.
+   */
+  inline unsigned int GetBinN(void){ return nbins; };
+
+  /**
+   * @brief Returns the frequency resolution [Hz].
+   */
+  inline double GetFrequencyResolution(void){ return (double)fs/(double)nseg; };
+
+  /**
+   * @brief Returns the PSD in a frequency bin [Hz\f$^{-1}\f$].
+   * @pre At least one periodogram must have been added.
+   * @param[in] aBinIndex Frequency bin index: must be valid.
+   */
+  inline double GetPower(const unsigned int aBinIndex){
+    return median[aBinIndex].GetMedian()/bias;
+  };
+
+  /**
+   * @brief Returns the PSD at a given frequency [Hz\f$^{-1}\f$].
+   * @details The PSD is linearly interpolated between frequency bins.
+   * 0 is returned if the frequency is out of range.
+   * @pre At least one periodogram must have been added.
+   * @param[in] aFrequency Frequency [Hz].
+   */
+  double GetPower(const double aFrequency);
+
+  /**
+   * @brief Returns the median bias.
+   * @details The median of \f$W\f$ exponentially distributed values (periodograms of Gaussian noise) is biased with respect to the mean.
+   * For odd \f$W\f$, the bias is \f$\sum_{i=1}^{W}(-1)^{i+1}/i\f$. For even \f$W\f$, the median is the mean of the two central values, and the bias is approximated by the value for \f$W+1\f$.
+   * @param[in] aN Number of values \f$W\f$.
+   */
+  static double MedianBias(const unsigned int aN);
+
+ private:
+
+  unsigned int fs;          ///< Sampling frequency [Hz].
+  unsigned int nseg;        ///< Segment size \f$N\f$.
+  unsigned int nbins;       ///< Number of frequency bins.
+  unsigned int nwin;        ///< Number of periodograms in the running median \f$W\f$.
+  Omedian *median;          ///< Running median / frequency bin.
+  double *hann;             ///< Hann window.
+  double norm;              ///< Periodogram normalization.
+  double bias;              ///< Current median bias.
+  double *segment;          ///< Segment buffer.
+  fftw_complex *segment_f;  ///< Segment Fourier transform.
+  fftw_plan plan;           ///< Segment fft plan.
+
+};
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file 
+ * @brief Omicron time-indexed ring buffer.
+ */
+#ifndef __Oring__
+#define __Oring__
+
+#include <cstring>
+
+using namespace std;
+
+/**
+ * @brief Time-indexed ring buffer of data samples.
+ * @details This class is designed to keep the last samples of a data stream, indexed by GPS time, to avoid reading the same data twice.
+ * For consecutive overlapping chunks, only the part of a chunk which is not in the buffer needs to be read: see GetMissing().
+ *
+ * The buffer contains the samples of a contiguous time range \f$[t_s, t_e[\f$, with integer GPS times.
+ * The capacity of the buffer is a fixed duration: when new samples are added with Put(), the oldest samples are overwritten.
+ * If the new samples are not contiguous with the buffer content, the buffer is reset.
+ */
+class Oring{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Oring class.
+   * @param[in] aSamplingFrequency Sampling frequency [Hz].
+   * @param[in] aDuration Buffer capacity [s]: it should be at least the chunk duration.
+   */
+  Oring(const unsigned int aSamplingFrequency, const unsigned int aDuration);
+
+  /**
+   * @brief Destructor of the Oring class.
+   */
+  virtual ~Oring(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Empties the buffer.
+   */
+  inline void Reset(void){
+    ts = 0;
+    te = 0;
+    head = 0;
+  };
+
+  /**
+   * @brief Returns the sampling frequency [Hz].
+   */
+  inline unsigned int GetSamplingFrequency(void){ return fs; };
+
+  /**
+   * @brief Returns the GPS start time of the buffer content [s].
+   */
+  inline unsigned int GetTimeStart(void){ return ts; };
+
+  /**
+   * @brief Returns the GPS end time of the buffer content [s].
+   */
+  inline unsigned int GetTimeEnd(void){ return te; };
+
+  /**
+   * @brief Returns true if a time range is fully contained in the buffer.
+   * @param[in] aTimeStart GPS start time [s].
+   * @param[in] aTimeEnd GPS end time [s].
+   */
+  inline bool Contains(const unsigned int aTimeStart, const unsigned int aTimeEnd){
+    return (aTimeStart>=ts)&&(aTimeEnd<=te)&&(aTimeStart<aTimeEnd);
+  };
+
+  /**
+   * @brief Returns the time range to read to get a time range.
+   * @details If the start of the requested range is in the buffer, only the part after the buffer end must be read.
+   * Otherwise, the full requested range must be read.
+   * @returns false if the requested range is already in the buffer: nothing to read.
+   * @param[in] aTimeStart Requested GPS start time [s].
+   * @param[in] aTimeEnd Requested GPS end time [s].
+   * @param[out] aReadStart GPS start time to read [s].
+   * @param[out] aReadEnd GPS end time to read [s].
+   */
+  bool GetMissing(const unsigned int aTimeStart, const unsigned int aTimeEnd,
+                  unsigned int &aReadStart, unsigned int &aReadEnd);
+
+  /**
+   * @brief Adds samples to the buffer.
+   * @details If the samples start at the buffer end, they are appended. Otherwise, the buffer is reset first.
+   * If the buffer capacity is exceeded, the oldest samples are dropped.
+   * @param[in] aTimeStart GPS start time of the samples [s].
+   * @param[in] aTimeEnd GPS end time of the samples [s].
+   * @param[in] aData Samples: \f$(t_{end}-t_{start})f_s\f$ values.
+   */
+  void Put(const unsigned int aTimeStart, const unsigned int aTimeEnd, const double *aData);
+
+  /**
+   * @brief Copies samples from the buffer.
+   * @returns false if the time range is not fully contained in the buffer.
+   * @param[in] aTimeStart GPS start time [s].
+   * @param[in] aTimeEnd GPS end time [s].
+   * @param[out] aData Output vector: \f$(t_{end}-t_{start})f_s\f$ values.
+   */
+  bool Read(const unsigned int aTimeStart, const unsigned int aTimeEnd, double *aData);
+
+ private:
+
+  unsigned int fs;              ///< Sampling frequency [Hz].
+  long unsigned int capacity;   ///< Buffer capacity (number of samples).
+  double *ring;                 ///< Ring buffer.
+  long unsigned int head;       ///< Ring index of the first sample.
+  unsigned int ts;              ///< GPS start time of the buffer content [s].
+  unsigned int te;              ///< GPS end time of the buffer content [s].
+
+  /**
+   * @brief Returns the number of samples in the buffer.
+   */
+  inline long unsigned int GetSize(void){ return (long unsigned int)(te-ts)*(long unsigned int)fs; };
+
+};
+
+#endif
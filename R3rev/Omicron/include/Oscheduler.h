@@ -0,0 +1,139 @@
+/**
+ * @file 
+ * @brief Omicron work-stealing scheduler.
+ */
+#ifndef __Oscheduler__
+#define __Oscheduler__
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+/**
+ * @brief Schedule work items over threads or processes.
+ * @details This class is designed to run a list of independent work items with very different costs, for example (channel, segment) pairs.
+ * Each item is given a cost hint: see AddItem().
+ *
+ * Two modes are supported:
+ * - Threads (RunThreads()): the items are first distributed over per-worker deques, largest cost first, each item going to the least-loaded worker.
+ * A worker processes the items at the front of its own deque.
+ * When its deque is empty, it steals an item from the back of the deque of the worker with the largest remaining cost.
+ * - Processes (RunProcesses()): the worker processes are forked from the calling process.
+ * The items are sorted by decreasing cost and the workers pick the next item with an atomic counter in a shared memory page.
+ *
+ * In both modes, every item is processed exactly once.
+ * The items are processed by a user function receiving the item index and the worker index.
+ */
+class Oscheduler{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Oscheduler class.
+   * @param[in] aWorkerN Number of workers. If 0, the number of hardware threads is used.
+   */
+  Oscheduler(const unsigned int aWorkerN);
+
+  /**
+   * @brief Destructor of the Oscheduler class.
+   */
+  virtual ~Oscheduler(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the number of workers.
+   */
+  inline unsigned int GetWorkerN(void){ return nworkers; };
+
+  /**
+   * @brief Returns the number of items.
+   */
+  inline unsigned int GetItemN(void){ return cost.size(); };
+
+  /**
+   * @brief Adds a work item.
+   * @returns The item index.
+   * @param[in] aCost Cost hint: only the relative costs of the items matter.
+   */
+  unsigned int AddItem(const double aCost);
+
+  /**
+   * @brief Returns the cost hint of an Omicron work item.
+   * @details The cost is the number of tiles to project, weighted by the trigger rate: \f$N_{tiles}(1+r/r_{max})\f$.
+   * The trigger rate is the one measured for the same channel previously (0 if unknown).
+   * @param[in] aTileN Number of tiles to project: number of tiles per chunk (Otile::GetTileN()) times the number of chunks.
+   * @param[in] aTriggerRate Previous trigger rate [Hz].
+   * @param[in] aTriggerRateMax Maximum trigger rate [Hz].
+   */
+  static double GetCost(const double aTileN, const double aTriggerRate, const double aTriggerRateMax);
+
+  /**
+   * @brief Removes all the items.
+   */
+  inline void Clear(void){ cost.clear(); };
+
+  /**
+   * @brief Processes the items with threads.
+   * @details The calling thread is the worker with index 0.
+   * The function returns when all the items are processed.
+   * @returns The number of items processed by each worker.
+   * @param[in] aWork Function processing an item. The first argument is the item index, the second one is the worker index.
+   */
+  vector<unsigned int> RunThreads(function<void(const unsigned int, const unsigned int)> aWork);
+
+  /**
+   * @brief Processes the items with processes.
+   * @details The worker processes are forked: the worker 0 is a forked process too, so the calling process only waits.
+   * The work function runs in the forked processes: it must save its results to disk.
+   * @returns The number of worker processes which failed (non-zero exit status). -1 is returned if the shared memory or a fork failed.
+   * @param[in] aWork Function processing an item. The first argument is the item index, the second one is the worker index. It returns false if the processing failed.
+   */
+  int RunProcesses(function<bool(const unsigned int, const unsigned int)> aWork);
+
+ private:
+
+  unsigned int nworkers;                ///< Number of workers.
+  vector<double> cost;                  ///< Item cost hints.
+  vector<deque<unsigned int>> queues;   ///< Item queues / worker.
+  vector<double> load;                  ///< Remaining cost / worker.
+  vector<mutex> locks;                  ///< Queue locks / worker.
+
+  /**
+   * @brief Returns the item indices sorted by decreasing cost.
+   * @details Items with the same cost keep their order.
+   */
+  vector<unsigned int> GetOrder(void);
+
+  /**
+   * @brief Takes the next item of a worker.
+   * @returns false if there is no item left to process.
+   * @param[in] aWorkerIndex Worker index.
+   * @param[out] aItem Item index.
+   */
+  bool Take(const unsigned int aWorkerIndex, unsigned int &aItem);
+
+  /**
+   * @brief Worker loop.
+   * @param[in] aWorkerIndex Worker index.
+   * @param[in] aWork Work function.
+   * @param[out] aDone Number of items processed by this worker.
+   */
+  void Work(const unsigned int aWorkerIndex,
+            function<void(const unsigned int, const unsigned int)> &aWork,
+            unsigned int &aDone);
+
+};
+
+#endif
@@ -0,0 +1,255 @@
+/**
+ * @file
+ * @brief Omicron vectorized kernels.
+ * @details This module provides the inner loops of the Q-transform and of the data decimation with explicit AVX2 and AVX-512 implementations.
+ * The instruction set is selected at runtime, when a kernel is called for the first time: see OsimdGetType().
+ * A scalar implementation is always available.
+ *
+ * The vectorized kernels perform exactly the same floating-point operations, in the same order, as the scalar kernels.
+ * The products are never contracted into fused multiply-add instructions, whatever the compilation flags (see src/Osimd.cc), so all the implementations return identical results.
+ *
+ * The single-precision kernels (suffix F) are only kernels: the Q-transform of the prebuilt Omicron library (Oqplane) does not use them and has no single-precision path.
+ * Their deviation from the double-precision kernels is bounded by the tests, on random data; the trigger SNR of a full single-precision Q-transform was never compared with the reference triggers.
+ */
+#ifndef __Osimd__
+#define __Osimd__
+
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define O_SIMD_X86
+#endif
+
+using namespace std;
+
+/**
+ * @brief List of instruction sets for the Omicron kernels.
+ */
+enum OsimdType{
+               osimd_scalar = 0,  ///< Scalar instructions.
+               osimd_avx2,        ///< AVX2 instructions.
+               osimd_avx512,      ///< AVX-512 (F) instructions.
+               osimd_n            ///< Number of instruction sets.
+};
+
+/**
+ * @brief Multiplies a complex vector by a complex window (scalar).
+ * @details \f$y_k = x_k \times (w^r_k + i w^i_k)\f$ for \f$0\le k<n\f$.
+ * Complex vectors are interleaved (real, imaginary), as `fftw_complex` arrays.
+ * @param[in] aN Number of complex samples \f$n\f$.
+ * @param[in] aIn Input complex vector \f$x\f$.
+ * @param[in] aWindowRe Window, real part \f$w^r\f$.
+ * @param[in] aWindowIm Window, imaginary part \f$w^i\f$.
+ * @param[out] aOut Output complex vector \f$y\f$. It can be the input vector.
+ */
+void OsimdWindowScalar(const unsigned int aN, const double *aIn,
+                       const double *aWindowRe, const double *aWindowIm, double *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it (scalar).
+ * @details For each complex tile value \f$z_k\f$, the SNR squared is \f$\max(|z_k|^2-2, 0)\f$.
+ * The maximum SNR squared is returned and the number of tiles with a SNR squared above a threshold is counted.
+ * With a threshold smaller than or equal to 0, all the tiles are counted.
+ * Optionally, the indices of the tiles above threshold are saved, in increasing order.
+ *
+ * A tile with a NaN value is ignored: it is not counted and it does not contribute to the maximum.
+ * @param[in] aN Number of tiles.
+ * @param[in] aZ Complex tile values (interleaved).
+ * @param[in] aSnrSqThr SNR squared threshold.
+ * @param[out] aAboveN Number of tiles with a SNR squared larger than or equal to the threshold.
+ * @param[out] aAboveIndex Array to save the indices of the tiles above threshold. It must be allocated with at least \f$n\f$ elements. Use NULL to only count the tiles.
+ */
+double OsimdSnrSqScalar(const unsigned int aN, const double *aZ,
+                        const double aSnrSqThr, long unsigned int &aAboveN,
+                        unsigned int *aAboveIndex=NULL);
+
+/**
+ * @brief Multiplies a complex vector by a complex window, in single precision (scalar).
+ * @details The input vector is in double precision. It is converted to single precision before the multiplication.
+ * @sa OsimdWindowScalar().
+ * @param[in] aN Number of complex samples \f$n\f$.
+ * @param[in] aIn Input complex vector \f$x\f$ (double precision).
+ * @param[in] aWindowRe Window, real part \f$w^r\f$.
+ * @param[in] aWindowIm Window, imaginary part \f$w^i\f$.
+ * @param[out] aOut Output complex vector \f$y\f$ (single precision).
+ */
+void OsimdWindowScalarF(const unsigned int aN, const double *aIn,
+                        const float *aWindowRe, const float *aWindowIm, float *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it, in single precision (scalar).
+ * @sa OsimdSnrSqScalar().
+ * @param[in] aN Number of tiles.
+ * @param[in] aZ Complex tile values (interleaved, single precision).
+ * @param[in] aSnrSqThr SNR squared threshold.
+ * @param[out] aAboveN Number of tiles with a SNR squared larger than or equal to the threshold.
+ * @param[out] aAboveIndex Array to save the indices of the tiles above threshold. Use NULL to only count the tiles.
+ */
+double OsimdSnrSqScalarF(const unsigned int aN, const float *aZ,
+                         const float aSnrSqThr, long unsigned int &aAboveN,
+                         unsigned int *aAboveIndex=NULL);
+
+/**
+ * @brief Reduces 8 partial sums.
+ * @details The partial sums are added in a fixed order: \f$((s_0+s_1)+(s_2+s_3))+((s_4+s_5)+(s_6+s_7))\f$.
+ * @param[in] aS Partial sums.
+ */
+double OsimdSum8(const double *aS);
+
+/**
+ * @brief Computes the dot product of two real vectors (scalar).
+ * @details The products are accumulated in 8 partial sums: \f$s_j = \sum_k a_{8k+j}b_{8k+j}\f$.
+ * The partial sums are reduced with OsimdSum8(), and the remaining \f$n \bmod 8\f$ products are added sequentially.
+ * @param[in] aN Vector size \f$n\f$.
+ * @param[in] aA First vector \f$a\f$.
+ * @param[in] aB Second vector \f$b\f$.
+ */
+double OsimdDotScalar(const unsigned int aN, const double *aA, const double *aB);
+
+#ifdef O_SIMD_X86
+
+/**
+ * @brief Multiplies a complex vector by a complex window (AVX2).
+ * @sa OsimdWindowScalar().
+ */
+__attribute__((target("avx2")))
+void OsimdWindowAvx2(const unsigned int aN, const double *aIn,
+                     const double *aWindowRe, const double *aWindowIm, double *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it (AVX2).
+ * @sa OsimdSnrSqScalar().
+ */
+__attribute__((target("avx2")))
+double OsimdSnrSqAvx2(const unsigned int aN, const double *aZ,
+                      const double aSnrSqThr, long unsigned int &aAboveN,
+                      unsigned int *aAboveIndex=NULL);
+
+/**
+ * @brief Computes the dot product of two real vectors (AVX2).
+ * @sa OsimdDotScalar().
+ */
+__attribute__((target("avx2")))
+double OsimdDotAvx2(const unsigned int aN, const double *aA, const double *aB);
+
+/**
+ * @brief Multiplies a complex vector by a complex window (AVX-512).
+ * @sa OsimdWindowScalar().
+ */
+__attribute__((target("avx512f")))
+void OsimdWindowAvx512(const unsigned int aN, const double *aIn,
+                       const double *aWindowRe, const double *aWindowIm, double *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it (AVX-512).
+ * @sa OsimdSnrSqScalar().
+ */
+__attribute__((target("avx512f")))
+double OsimdSnrSqAvx512(const unsigned int aN, const double *aZ,
+                        const double aSnrSqThr, long unsigned int &aAboveN,
+                        unsigned int *aAboveIndex=NULL);
+
+/**
+ * @brief Computes the dot product of two real vectors (AVX-512).
+ * @sa OsimdDotScalar().
+ */
+__attribute__((target("avx512f")))
+double OsimdDotAvx512(const unsigned int aN, const double *aA, const double *aB);
+
+/**
+ * @brief Multiplies a complex vector by a complex window, in single precision (AVX2).
+ * @sa OsimdWindowScalarF().
+ */
+__attribute__((target("avx2")))
+void OsimdWindowAvx2F(const unsigned int aN, const double *aIn,
+                      const float *aWindowRe, const float *aWindowIm, float *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it, in single precision (AVX2).
+ * @sa OsimdSnrSqScalarF().
+ */
+__attribute__((target("avx2")))
+double OsimdSnrSqAvx2F(const unsigned int aN, const float *aZ,
+                       const float aSnrSqThr, long unsigned int &aAboveN,
+                       unsigned int *aAboveIndex=NULL);
+
+#endif
+
+/**
+ * @brief Returns the instruction set used by the Omicron kernels.
+ * @details The instruction set is detected once, at the first call.
+ * The best instruction set supported by the CPU is selected.
+ * It is possible to force a lower instruction set with the environment variable `$OMICRON_SIMD` = "scalar", "avx2" or "avx512".
+ */
+OsimdType OsimdGetType(void);
+
+/**
+ * @brief Multiplies a complex vector by a complex window.
+ * @details The implementation is selected with OsimdGetType().
+ * @sa OsimdWindowScalar().
+ * @param[in] aN Number of complex samples \f$n\f$.
+ * @param[in] aIn Input complex vector \f$x\f$.
+ * @param[in] aWindowRe Window, real part \f$w^r\f$.
+ * @param[in] aWindowIm Window, imaginary part \f$w^i\f$.
+ * @param[out] aOut Output complex vector \f$y\f$. It can be the input vector.
+ */
+void OsimdWindow(const unsigned int aN, const double *aIn,
+                 const double *aWindowRe, const double *aWindowIm, double *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it.
+ * @details The implementation is selected with OsimdGetType().
+ * @sa OsimdSnrSqScalar().
+ * @returns The maximum SNR squared.
+ * @param[in] aN Number of tiles.
+ * @param[in] aZ Complex tile values (interleaved).
+ * @param[in] aSnrSqThr SNR squared threshold.
+ * @param[out] aAboveN Number of tiles with a SNR squared larger than or equal to the threshold.
+ * @param[out] aAboveIndex Array to save the indices of the tiles above threshold, in increasing order. It must be allocated with at least \f$n\f$ elements. Use NULL to only count the tiles.
+ */
+double OsimdSnrSq(const unsigned int aN, const double *aZ,
+                  const double aSnrSqThr, long unsigned int &aAboveN,
+                  unsigned int *aAboveIndex=NULL);
+
+/**
+ * @brief Multiplies a complex vector by a complex window, in single precision.
+ * @details The implementation is selected with OsimdGetType().
+ * The AVX2 implementation is also used on AVX-512 CPUs.
+ * @sa OsimdWindowScalarF().
+ * @param[in] aN Number of complex samples \f$n\f$.
+ * @param[in] aIn Input complex vector \f$x\f$ (double precision).
+ * @param[in] aWindowRe Window, real part \f$w^r\f$.
+ * @param[in] aWindowIm Window, imaginary part \f$w^i\f$.
+ * @param[out] aOut Output complex vector \f$y\f$ (single precision).
+ */
+void OsimdWindow(const unsigned int aN, const double *aIn,
+                 const float *aWindowRe, const float *aWindowIm, float *aOut);
+
+/**
+ * @brief Computes the SNR squared of tiles and reduces it, in single precision.
+ * @details The implementation is selected with OsimdGetType().
+ * The AVX2 implementation is also used on AVX-512 CPUs.
+ * @sa OsimdSnrSqScalarF().
+ * @returns The maximum SNR squared.
+ * @param[in] aN Number of tiles.
+ * @param[in] aZ Complex tile values (interleaved, single precision).
+ * @param[in] aSnrSqThr SNR squared threshold.
+ * @param[out] aAboveN Number of tiles with a SNR squared larger than or equal to the threshold.
+ * @param[out] aAboveIndex Array to save the indices of the tiles above threshold, in increasing order. It must be allocated with at least \f$n\f$ elements. Use NULL to only count the tiles.
+ */
+double OsimdSnrSq(const unsigned int aN, const float *aZ,
+                  const float aSnrSqThr, long unsigned int &aAboveN,
+                  unsigned int *aAboveIndex=NULL);
+
+/**
+ * @brief Computes the dot product of two real vectors.
+ * @details The implementation is selected with OsimdGetType().
+ * @sa OsimdDotScalar().
+ * @param[in] aN Vector size \f$n\f$.
+ * @param[in] aA First vector \f$a\f$.
+ * @param[in] aB Second vector \f$b\f$.
+ */
+double OsimdDot(const unsigned int aN, const double *aA, const double *aB);
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file 
+ * @brief Omicron persistent tiling cache.
+ */
+#ifndef __Otilecache__
+#define __Otilecache__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Persistent cache of tiling arrays and fftw wisdom.
+ * @details This class is designed to save the expensive parts of a tiling construction in a file, so that later processes with the same tiling parameters can skip them:
+ * - the fftw wisdom accumulated by the process, which makes the later fft planning immediate,
+ * - a list of named arrays of doubles, for example the bisquare windows and the band layouts of the Q-planes.
+ *
+ * The cache file is identified by a key string describing the tiling parameters: see MakeKey().
+ * The cache file is written with Write(), in a temporary file which is then renamed: concurrent processes can safely write the same cache file.
+ *
+ * When an Otilecache object is constructed, the cache file is memory-mapped (read-only): the arrays are not copied.
+ * The cache file is rejected if the key does not match or if the file is corrupted: every offset and size is checked against the file size, and the strings must be null-terminated.
+ * The fftw wisdom is imported with ImportWisdom().
+ *
+ * The file contains:
+ * - a header,
+ * - the array records: name offset in the string table, offset in the data section and number of values,
+ * - the data section (doubles),
+ * - the key, the fftw wisdom and the string table (array names), each null-terminated.
+ */
+class Otilecache{
+
+ public:
+  
+  /**
+   * @name Constructors and destructors
+   @{
+  */
+  /**
+   * @brief Constructor of the Otilecache class.
+   * @details The cache file is memory-mapped and checked.
+   * @param[in] aFilePath Path to the cache file.
+   * @param[in] aKey Key of the tiling parameters: see MakeKey().
+   */
+  Otilecache(const string aFilePath, const string aKey);
+
+  /**
+   * @brief Destructor of the Otilecache class.
+   * @details The cache file is unmapped.
+   */
+  virtual ~Otilecache(void);
+  /**
+     @}
+  */
+
+  /**
+   * @brief Returns the key of a set of tiling parameters.
+   * @details The parameters are written with 17 significant digits, so two parameter sets have the same key only if they are identical.
+   * @param[in] aTimeRange Chunk duration [s].
+   * @param[in] aTimeOverlap Overlap duration [s].
+   * @param[in] aQmin Minimum Q value.
+   * @param[in] aQmax Maximum Q value.
+   * @param[in] aFrequencyMin Minimum frequency [Hz].
+   * @param[in] aFrequencyMax Maximum frequency [Hz].
+   * @param[in] aSamplingFrequency Sampling frequency [Hz].
+   * @param[in] aMismatchMax Maximum mismatch between tiles.
+   */
+  static string MakeKey(const unsigned int aTimeRange, const unsigned int aTimeOverlap,
+                        const double aQmin, const double aQmax,
+                        const double aFrequencyMin, const double aFrequencyMax,
+                        const unsigned int aSamplingFrequency, const double aMismatchMax);
+
+  /**
+   * @brief Returns the default path of a cache file.
+   * @details The file name is derived from a hash of the key: `[aDirectory]/omicron-tiling-[hash].otc`.
+   * @param[in] aDirectory Cache directory.
+   * @param[in] aKey Key of the tiling parameters: see MakeKey().
+   */
+  static string MakeFilePath(const string aDirectory, const string aKey);
+
+  /**
+   * @brief Writes a cache file.
+   * @details The current fftw wisdom of the process is saved with the arrays.
+   * @returns false if the cache file cannot be written.
+   * @param[in] aFilePath Path to the cache file.
+   * @param[in] aKey Key of the tiling parameters: see MakeKey().
+   * @param[in] aNames Array names.
+   * @param[in] aArrays Arrays: same size as the list of names.
+   */
+  static bool Write(const string aFilePath, const string aKey,
+                    const vector<string> &aNames, const vector< vector<double> > &aArrays);
+
+  /**
+   * @brief Returns true if the cache file is valid.
+   * @details The cache file is valid if it exists, is consistent and matches the key.
+   */
+  inline bool IsValid(void){ return header!=NULL; };
+
+  /**
+   * @brief Imports the fftw wisdom saved in the cache file.
+   * @details The fftw planner is not thread-safe: this function must not be called while another thread creates a fftw plan.
+   * @returns false if the cache file is not valid or if the wisdom cannot be imported.
+   */
+  bool ImportWisdom(void);
+
+  /**
+   * @brief Returns the number of arrays.
+   */
+  inline unsigned int GetArrayN(void){ return header==NULL ? 0 : header->array_n; };
+
+  /**
+   * @brief Returns the index of an array.
+   * @returns -1 if the array is not found.
+   * @param[in] aName Array name.
+   */
+  int FindArray(const string aName);
+
+  /**
+   * @brief Returns the name of an array.
+   * @param[in] aArrayIndex Array index: must be valid.
+   */
+  inline string GetArrayName(const unsigned int aArrayIndex){ return string(strings+arrays[aArrayIndex].name); };
+
+  /**
+   * @brief Returns the number of values of an array.
+   * @param[in] aArrayIndex Array index: must be valid.
+   */
+  inline long unsigned int GetArraySize(const unsigned int aArrayIndex){ return arrays[aArrayIndex].size; };
+
+  /**
+   * @brief Returns the values of an array.
+   * @details The values are read in the mapped file: the pointer is valid as long as this object exists.
+   * @param[in] aArrayIndex Array index: must be valid.
+   */
+  inline const double* GetArray(const unsigned int aArrayIndex){ return data+arrays[aArrayIndex].offset; };
+
+ private:
+
+  /**
+   * @brief Cache file header.
+   */
+  struct Header{
+    char magic[8];                  ///< Magic string "OTCACHE".
+    uint32_t version;               ///< Format version.
+    uint32_t array_n;               ///< Number of arrays.
+    uint64_t data_n;                ///< Number of values in the data section.
+    uint64_t key_size;              ///< Size of the key [bytes].
+    uint64_t wisdom_size;           ///< Size of the fftw wisdom [bytes].
+    uint64_t string_size;           ///< Size of the string table [bytes].
+  };
+
+  /**
+   * @brief Cache file array record.
+   */
+  struct Array{
+    uint64_t name;                  ///< Name offset in the string table.
+    uint64_t offset;                ///< Offset of the first value in the data section.
+    uint64_t size;                  ///< Number of values.
+  };
+
+  void *map;                        ///< Mapped cache file.
+  long unsigned int map_size;       ///< Mapped size [bytes].
+  const Header *header;             ///< Header (NULL if the cache file is invalid).
+  const Array *arrays;              ///< Array records.
+  const double *data;               ///< Data section.
+  const char *wisdom;               ///< fftw wisdom.
+  const char *strings;              ///< String table.
+
+};
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file 
+ * @brief See Obatch.h
+ */
+#include "Obatch.h"
+#include "Osimd.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Obatch::Obatch(const unsigned int aSize, const unsigned int aRowN){
+////////////////////////////////////////////////////////////////////////////////////
+  size = aSize>0 ? aSize : 1;
+  rown = aRowN>0 ? aRowN : 1;
+  buffer = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*(long unsigned int)size*(long unsigned int)rown);
+  memset(buffer, 0, sizeof(fftw_complex)*(long unsigned int)size*(long unsigned int)rown);
+
+  // one plan for all the rows: contiguous rows, in place
+  int n[1] = {(int)size};
+  plan = fftw_plan_many_dft(1, n, (int)rown,
+                            buffer, NULL, 1, (int)size,
+                            buffer, NULL, 1, (int)size,
+                            FFTW_BACKWARD, FFTW_ESTIMATE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Obatch::~Obatch(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(plan!=NULL) fftw_destroy_plan(plan);
+  fftw_free(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Obatch::SetRow(const unsigned int aRowIndex, const unsigned int aN, const double *aIn,
+                    const double *aWindowRe, const double *aWindowIm, const unsigned int aOffset){
+////////////////////////////////////////////////////////////////////////////////////
+  fftw_complex *row = GetRow(aRowIndex);
+  unsigned int n = aN<size ? aN : size;
+  unsigned int o = aOffset%size;
+
+  // windowed data: [o, size[ then [0, n-(size-o)[
+  unsigned int n1 = n<size-o ? n : size-o;
+  OsimdWindow(n1, aIn, aWindowRe, aWindowIm, (double*)(row+o));
+  OsimdWindow(n-n1, aIn+2*n1, aWindowRe+n1, aWindowIm+n1, (double*)row);
+
+  // zeros
+  if(o+n<=size){
+    memset(row, 0, sizeof(fftw_complex)*o);
+    memset(row+o+n, 0, sizeof(fftw_complex)*(size-o-n));
+  }
+  else memset(row+(n-n1), 0, sizeof(fftw_complex)*(size-n));
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Obatch::Execute(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(plan!=NULL) fftw_execute(plan);
+}
@@ -0,0 +1,160 @@
+/**
+ * @file 
+ * @brief See Ocache.h
+ */
+#include "Ocache.h"
+#include <iostream>
+#include <cstring>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////
+Ocache::Ocache(const unsigned int aThreadN, const long unsigned int aMemoryBudget, const unsigned int aVerbosity){
+////////////////////////////////////////////////////////////////////////////////////
+  fVerbosity = aVerbosity;
+  budget = aMemoryBudget;
+  used = 0;
+  hit_n = 0;
+  miss_n = 0;
+  pool = new Opool(aThreadN);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Ocache::~Ocache(void){
+////////////////////////////////////////////////////////////////////////////////////
+  delete pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Ocache::Decode(const vector<Ogwf*> &aFiles, const vector<string> &aChannels,
+                            const double aGpsStart, const double aGpsEnd){
+////////////////////////////////////////////////////////////////////////////////////
+  lock_guard<mutex> run_lock(run_mtx);
+
+  // list new blocks
+  vector< pair<Ogwf*, unsigned int> > tasks;
+  vector<Key> keys;
+  vector<unsigned int> v;
+  {
+    lock_guard<mutex> lock(mtx);
+    for(unsigned int f=0; f<aFiles.size(); f++){
+      if(!aFiles[f]->GetStatus()) continue;
+      for(unsigned int c=0; c<aChannels.size(); c++){
+        aFiles[f]->GetVectors(aChannels[c], aGpsStart, aGpsEnd, v);
+        for(unsigned int i=0; i<v.size(); i++){
+          Key k(aFiles[f]->GetFilePath(), aChannels[c], aFiles[f]->GetVectorStart(v[i]));
+          if(blocks.count(k)||pending.count(k)) continue;
+          if(GetBlockSize(aFiles[f], v[i])>budget) continue;
+          pending.insert(k);
+          tasks.push_back(make_pair(aFiles[f], v[i]));
+          keys.push_back(k);
+        }
+      }
+    }
+  }
+
+  // decode
+  pool->Run(tasks.size(), [&](const unsigned int aTask, const unsigned int){
+      shared_ptr<Block> b = MakeBlock(tasks[aTask].first, tasks[aTask].second);
+      lock_guard<mutex> lock(mtx);
+      pending.erase(keys[aTask]);
+      if(b!=nullptr) Insert(keys[aTask], b);
+      cv.notify_all();
+    });
+
+  if(fVerbosity>1) cout<<"Ocache::Decode: "<<tasks.size()<<" blocks decoded, "<<used/1048576<<" MB used"<<endl;
+  return tasks.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+long unsigned int Ocache::Read(Ogwf *aFile, const string aChannelName, const double aGpsStart,
+                               const long unsigned int aSize, void *aBuffer,
+                               const OgwfType aType, const double aSamplingFrequency){
+////////////////////////////////////////////////////////////////////////////////////
+  if(!aFile->GetStatus()) return 0;
+  unsigned int tsize = Ogwf::GetTypeSize(aType);
+  if(tsize==0) return 0;
+
+  vector<unsigned int> v;
+  aFile->GetVectors(aChannelName, aGpsStart, aGpsStart+(double)aSize/aSamplingFrequency, v);
+  long unsigned int n = 0;
+  for(unsigned int i=0; i<v.size(); i++){
+    if(aFile->GetVectorType(v[i])!=aType) return 0;
+    if(fabs(aSamplingFrequency/aFile->GetVectorSamplingFrequency(v[i])-1.0)>1e-9) return 0;
+
+    // get block
+    Key k(aFile->GetFilePath(), aChannelName, aFile->GetVectorStart(v[i]));
+    shared_ptr<Block> b = Get(k);
+    if(b==nullptr){
+      b = MakeBlock(aFile, v[i]);
+      if(b==nullptr) return 0;
+      lock_guard<mutex> lock(mtx);
+      if(b->size<=budget) Insert(k, b);
+    }
+
+    // overlap in samples
+    long int v0 = lround((b->start-aGpsStart)*aSamplingFrequency);
+    long int i0 = max(v0, 0L);
+    long int i1 = min(v0+(long int)(b->size/tsize), (long int)aSize);
+    if(i1<=i0) continue;
+    memcpy((char*)aBuffer+i0*tsize, b->data.data()+(i0-v0)*tsize, (i1-i0)*tsize);
+    n += (long unsigned int)(i1-i0);
+  }
+  return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Ocache::Clear(void){
+////////////////////////////////////////////////////////////////////////////////////
+  lock_guard<mutex> lock(mtx);
+  blocks.clear();
+  lru.clear();
+  used = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+long unsigned int Ocache::GetBlockSize(Ogwf *aFile, const unsigned int aVectorIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  return aFile->GetVectorSampleN(aVectorIndex)*Ogwf::GetTypeSize(aFile->GetVectorType(aVectorIndex));
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+shared_ptr<Ocache::Block> Ocache::MakeBlock(Ogwf *aFile, const unsigned int aVectorIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  shared_ptr<Block> b = make_shared<Block>();
+  b->start = aFile->GetVectorStart(aVectorIndex);
+  b->size = GetBlockSize(aFile, aVectorIndex);
+  if(b->size==0) return nullptr;
+  b->data.resize(b->size);
+  if(!aFile->DecodeVector(aVectorIndex, b->data.data())) return nullptr;
+  return b;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+shared_ptr<Ocache::Block> Ocache::Get(const Key &aKey){
+////////////////////////////////////////////////////////////////////////////////////
+  unique_lock<mutex> lock(mtx);
+  cv.wait(lock, [&]{ return pending.count(aKey)==0; });
+  std::map<Key, Entry>::iterator it = blocks.find(aKey);
+  if(it==blocks.end()){
+    miss_n++;
+    return nullptr;
+  }
+  hit_n++;
+  lru.splice(lru.begin(), lru, it->second.second);
+  return it->second.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Ocache::Insert(const Key &aKey, shared_ptr<Block> aBlock){
+////////////////////////////////////////////////////////////////////////////////////
+  if(blocks.count(aKey)) return;
+  while((used+aBlock->size>budget)&&!lru.empty()){
+    std::map<Key, Entry>::iterator it = blocks.find(lru.back());
+    used -= it->second.first->size;
+    blocks.erase(it);
+    lru.pop_back();
+  }
+  lru.push_front(aKey);
+  blocks[aKey] = Entry(aBlock, lru.begin());
+  used += aBlock->size;
+}
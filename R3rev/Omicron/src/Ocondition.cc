@@ -0,0 +1,74 @@
+/**
+ * @file 
+ * @brief See Ocondition.h
+ */
+#include "Ocondition.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Ocondition::Ocondition(const unsigned int aNativeFrequency, const unsigned int aWorkingFrequency,
+                       const double aHighPassFrequency, const unsigned int aOrder){
+////////////////////////////////////////////////////////////////////////////////////
+  native = aNativeFrequency;
+  working = aWorkingFrequency;
+  highpass = aHighPassFrequency;
+  ratio = 0;
+  if((working>0)&&(native>=working)&&(native%working==0)) ratio = native/working;
+  if(highpass>=(double)native/2.0) highpass = 0.0;
+  nsos = (aOrder+1)/2;// odd order: rounded up
+  if(nsos==0) nsos = 1;
+
+  // high-pass second-order sections
+  nhp = 0;
+  if(highpass>0.0) nhp = nsos;
+  sos = new double [5*nhp+1];
+  state = new double [2*nhp+1];
+  for(unsigned int s=0; s<nhp; s++) MakeSection(s, highpass, 5*s);
+
+  // decimator
+  decimator = NULL;
+  if(ratio>1) decimator = new Odecimator(ratio);
+
+  block = new double [O_COND_BLOCK_SIZE];
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Ocondition::~Ocondition(void){
+////////////////////////////////////////////////////////////////////////////////////
+  delete [] sos;
+  delete [] state;
+  delete [] block;
+  if(decimator!=NULL) delete decimator;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Ocondition::MakeSection(const unsigned int aSectionIndex, const double aFrequency, const unsigned int aOffset){
+////////////////////////////////////////////////////////////////////////////////////
+  double qs = 1.0/(2.0*TMath::Sin(TMath::Pi()*(2.0*(double)aSectionIndex+1.0)/(4.0*(double)nsos)));
+  double k = TMath::Tan(TMath::Pi()*aFrequency/(double)native);
+  double norm = 1.0/(1.0+k/qs+k*k);
+  sos[aOffset+0] = norm;
+  sos[aOffset+1] = -2.0*norm;
+  sos[aOffset+2] = norm;
+  sos[aOffset+3] = 2.0*(k*k-1.0)*norm;
+  sos[aOffset+4] = (1.0-k/qs+k*k)*norm;
+  return;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Ocondition::Filter(const unsigned int aN, const unsigned int aOffset, const unsigned int aStateOffset){
+////////////////////////////////////////////////////////////////////////////////////
+  const double b0 = sos[aOffset+0], b1 = sos[aOffset+1], b2 = sos[aOffset+2];
+  const double a1 = sos[aOffset+3], a2 = sos[aOffset+4];
+  double z1 = state[aStateOffset], z2 = state[aStateOffset+1];
+  double x, y;
+  for(unsigned int i=0; i<aN; i++){
+    x = block[i];
+    y = b0*x+z1;
+    z1 = b1*x-a1*y+z2;
+    z2 = b2*x-a2*y;
+    block[i] = y;
+  }
+  state[aStateOffset] = z1;
+  state[aStateOffset+1] = z2;
+  return;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file 
+ * @brief See Odecimator.h
+ */
+#include "Odecimator.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Odecimator::Odecimator(const unsigned int aRatio, const unsigned int aHalfLength,
+                       const double aCutoff, const double aBeta){
+////////////////////////////////////////////////////////////////////////////////////
+  ratio = aRatio;
+  if(ratio==0) ratio = 1;
+  half = ratio*TMath::Max(aHalfLength, (unsigned int)1);// K=0: division by 0 in the window
+  length = 2*half+1;
+
+  // windowed sinc
+  h = new double [length];
+  double fc = aCutoff/(2.0*(double)ratio);// cutoff / input sampling frequency
+  double x, sum = 0.0;
+  for(unsigned int k=0; k<length; k++){
+    x = (double)k-(double)half;
+    if(k==half) h[k] = 2.0*fc;
+    else h[k] = TMath::Sin(2.0*TMath::Pi()*fc*x)/(TMath::Pi()*x);
+    h[k] *= BesselI0(aBeta*TMath::Sqrt(1.0-(x/(double)half)*(x/(double)half)))/BesselI0(aBeta);
+    sum += h[k];
+  }
+  for(unsigned int k=0; k<length; k++) h[k] /= sum;// unity gain at DC
+
+  buffer = new double [length+half+O_COND_BLOCK_SIZE];
+  Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Odecimator::~Odecimator(void){
+////////////////////////////////////////////////////////////////////////////////////
+  delete [] h;
+  delete [] buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Odecimator::Reset(void){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int k=0; k<half; k++) buffer[k] = 0.0;
+  nbuf = half;
+  next = half;
+  n_in = 0;
+  n_out = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Odecimator::Push(const unsigned int aN, const double *aIn, double *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int o = 0, n;
+  for(unsigned int i=0; i<aN; i+=n){
+    n = TMath::Min((unsigned int)O_COND_BLOCK_SIZE, aN-i);
+    memcpy(buffer+nbuf, aIn+i, n*sizeof(double));
+    nbuf += n;
+    n_in += n;
+    o += Decimate(aOut+o, n_in);
+  }
+  return o;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Odecimator::Flush(double *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int k=0; k<half; k++) buffer[nbuf+k] = 0.0;
+  nbuf += half;
+  unsigned int o = Decimate(aOut, n_in);
+  Reset();
+  return o;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Odecimator::Decimate(double *aOut, const long unsigned int aInN){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int o = 0;
+  while((next+half<nbuf)&&(n_out*(long unsigned int)ratio<aInN)){
+    aOut[o++] = OsimdDot(length, h, buffer+next-half);
+    next += ratio;
+    n_out++;
+  }
+  unsigned int shift = next-half;
+  memmove(buffer, buffer+shift, (nbuf-shift)*sizeof(double));
+  nbuf -= shift;
+  next -= shift;
+  return o;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double Odecimator::BesselI0(const double aX){
+////////////////////////////////////////////////////////////////////////////////////
+  double sum = 1.0, term = 1.0;
+  for(unsigned int k=1; k<50; k++){
+    term *= (aX/(2.0*(double)k))*(aX/(2.0*(double)k));
+    sum += term;
+    if(term<1e-17*sum) break;
+  }
+  return sum;
+}
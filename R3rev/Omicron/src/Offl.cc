@@ -0,0 +1,199 @@
+/**
+ * @file 
+ * @brief See Offl.h
+ */
+#include "Offl.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+////////////////////////////////////////////////////////////////////////////////////
+Offl::Offl(const string aFflFile, const string aIndexFile){
+////////////////////////////////////////////////////////////////////////////////////
+  map = NULL;
+  map_size = 0;
+  header = NULL;
+  frames = NULL;
+  chans = NULL;
+  strings = NULL;
+
+  string idx = aIndexFile.empty() ? aFflFile+".oidx" : aIndexFile;
+  long unsigned int fsize, fmtime;
+  if(!GetFileStat(aFflFile, fsize, fmtime)) return;
+
+  int fd = open(idx.c_str(), O_RDONLY);
+  if(fd<0) return;
+  struct stat st;
+  if((fstat(fd, &st)==0)&&((long unsigned int)st.st_size>=sizeof(Header))){
+    map_size = st.st_size;
+    map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map==MAP_FAILED) map = NULL;
+  }
+  close(fd);
+  if(map==NULL) return;
+
+  // check header and sizes (each size is bounded first: the sum cannot overflow)
+  const Header *h = (const Header*)map;
+  bool ok = !memcmp(h->magic, "OFFLIDX", 8)&&(h->version==1)&&(h->ffl_size==fsize)&&(h->ffl_mtime==fmtime)&&
+    (h->frame_n<=map_size/sizeof(Frame))&&(h->channel_n<=map_size/sizeof(Channel))&&(h->string_size<=map_size)&&
+    (sizeof(Header)+h->frame_n*sizeof(Frame)+h->channel_n*sizeof(Channel)+h->string_size==map_size)&&
+    (h->string_size>0);
+
+  // check string offsets: the string table must end with a null character
+  if(ok){
+    frames = (const Frame*)((const char*)map+sizeof(Header));
+    chans = (const Channel*)(frames+h->frame_n);
+    strings = (const char*)(chans+h->channel_n);
+    ok = (strings[h->string_size-1]=='\0');
+    for(long unsigned int f=0; ok&&(f<h->frame_n); f++) ok = (frames[f].path<h->string_size);
+    for(unsigned int c=0; ok&&(c<h->channel_n); c++) ok = (chans[c].name<h->string_size);
+  }
+
+  if(!ok){
+    munmap(map, map_size);
+    map = NULL;
+    frames = NULL;
+    chans = NULL;
+    strings = NULL;
+    return;
+  }
+  header = h;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Offl::~Offl(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(map!=NULL) munmap(map, map_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Offl::Build(const string aFflFile, const vector<string> &aChannels,
+                 const vector<unsigned int> &aSampling, const string aIndexFile){
+////////////////////////////////////////////////////////////////////////////////////
+  if(aSampling.size()!=aChannels.size()) return false;
+  string idx = aIndexFile.empty() ? aFflFile+".oidx" : aIndexFile;
+  Header h;
+  if(!GetFileStat(aFflFile, h.ffl_size, h.ffl_mtime)) return false;
+
+  // parse frame file list
+  ifstream in(aFflFile.c_str());
+  if(!in.is_open()) return false;
+  vector<Frame> fr;
+  string strtab, line;
+  vector<string> w;
+  while(getline(in, line)){
+    w.clear();
+    istringstream ls(line);
+    string word;
+    while(ls>>word) w.push_back(word);
+    if(w.empty()||(w[0][0]=='#')) continue;
+    Frame f;
+    string path;
+    if((w.size()>=5)&&(w[4].find("file://")==0)){// LCF
+      path = w[4].substr(7);
+      if(path.find("localhost")==0) path = path.substr(9);
+      f.start = atof(w[2].c_str());
+      f.duration = atof(w[3].c_str());
+    }
+    else{// FFL: the first 2 numerical fields after the path
+      vector<double> num;
+      char *end;
+      for(unsigned int i=1; (i<w.size())&&(num.size()<2); i++){
+        double v = strtod(w[i].c_str(), &end);
+        if(*end=='\0') num.push_back(v);
+      }
+      if(num.size()<2) continue;
+      path = w[0];
+      f.start = num[0];
+      f.duration = num[1];
+    }
+    f.path = strtab.size();
+    strtab += path;
+    strtab.push_back('\0');
+    fr.push_back(f);
+  }
+  in.close();
+  stable_sort(fr.begin(), fr.end(), [](const Frame &a, const Frame &b){ return a.start<b.start; });
+
+  // remove duplicated frames
+  unsigned int n = 0;
+  for(unsigned int i=0; i<fr.size(); i++){
+    if((n>0)&&(fr[i].start==fr[n-1].start)&&(fr[i].duration==fr[n-1].duration)&&
+       !strcmp(strtab.c_str()+fr[i].path, strtab.c_str()+fr[n-1].path)) continue;
+    fr[n++] = fr[i];
+  }
+  fr.resize(n);
+
+  // channel table
+  vector<Channel> ch(aChannels.size());
+  for(unsigned int c=0; c<aChannels.size(); c++){
+    ch[c].name = strtab.size();
+    ch[c].sampling = aSampling[c];
+    strtab += aChannels[c];
+    strtab.push_back('\0');
+  }
+
+  // write
+  memcpy(h.magic, "OFFLIDX", 8);
+  h.version = 1;
+  h.frame_n = fr.size();
+  h.channel_n = ch.size();
+  h.string_size = strtab.size();
+  string tmp = idx+".tmp."+to_string(getpid());
+  FILE *out = fopen(tmp.c_str(), "wb");
+  if(out==NULL) return false;
+  bool ok = (fwrite(&h, sizeof(Header), 1, out)==1);
+  if(fr.size()) ok = ok&&(fwrite(fr.data(), sizeof(Frame), fr.size(), out)==fr.size());
+  if(ch.size()) ok = ok&&(fwrite(ch.data(), sizeof(Channel), ch.size(), out)==ch.size());
+  if(strtab.size()) ok = ok&&(fwrite(strtab.data(), 1, strtab.size(), out)==strtab.size());
+  ok = (fclose(out)==0)&&ok;
+  if(!ok||rename(tmp.c_str(), idx.c_str())){
+    remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+int Offl::FindFrame(const double aGps){
+////////////////////////////////////////////////////////////////////////////////////
+  int i = UpperBound(aGps)-1;
+  for(int j=i; (j>=0)&&(frames[j].start==frames[i].start); j--)
+    if(aGps<frames[j].start+frames[j].duration) return j;
+  return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Offl::GetFrames(const double aTimeStart, const double aTimeEnd,
+                     unsigned int &aFirst, unsigned int &aLast){
+////////////////////////////////////////////////////////////////////////////////////
+  aLast = UpperBound(aTimeEnd);
+  while((aLast>0)&&(frames[aLast-1].start>=aTimeEnd)) aLast--;// frames starting at aTimeEnd
+  aFirst = UpperBound(aTimeStart);
+  while((aFirst>0)&&(frames[aFirst-1].start+frames[aFirst-1].duration>aTimeStart)) aFirst--;
+  return aFirst<aLast;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Offl::UpperBound(const double aGps){
+////////////////////////////////////////////////////////////////////////////////////
+  if(header==NULL) return 0;
+  return upper_bound(frames, frames+header->frame_n, aGps,
+                     [](const double g, const Frame &f){ return g<f.start; })-frames;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Offl::GetFileStat(const string aFile, long unsigned int &aSize, long unsigned int &aMtime){
+////////////////////////////////////////////////////////////////////////////////////
+  struct stat st;
+  if(stat(aFile.c_str(), &st)) return false;
+  aSize = st.st_size;
+  aMtime = (long unsigned int)st.st_mtim.tv_sec*1000000000UL+(long unsigned int)st.st_mtim.tv_nsec;
+  return true;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file 
+ * @brief See Oframe.h
+ */
+#include "Oframe.h"
+#include <iostream>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////
+Oframe::Oframe(const vector<string> &aChannels, const unsigned int aVerbosity){
+////////////////////////////////////////////////////////////////////////////////////
+  fVerbosity = aVerbosity;
+  chans.resize(aChannels.size());
+  for(unsigned int c=0; c<chans.size(); c++){
+    chans[c].name = aChannels[c];
+    chans[c].type = ogwf_type_unknown;
+    chans[c].fs = 0.0;
+    chans[c].n = 0;
+    chans[c].loaded = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oframe::~Oframe(void){
+////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Oframe::Load(const vector<string> &aFiles, const double aGpsStart, const double aGpsEnd){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int c=0; c<chans.size(); c++){
+    chans[c].type = ogwf_type_unknown;
+    chans[c].fs = 0.0;
+    chans[c].n = 0;
+    chans[c].loaded = 0;
+    chans[c].data.clear();
+  }
+
+  unsigned int nfiles = 0;
+  for(unsigned int f=0; f<aFiles.size(); f++){
+
+    // one mapping and one index per file
+    Ogwf gwf(aFiles[f], fVerbosity);
+    if(!gwf.GetStatus()) continue;
+    nfiles++;
+
+    // all channels
+    for(unsigned int c=0; c<chans.size(); c++){
+      if(chans[c].type==ogwf_type_unknown){
+        OgwfType type;
+        double fs;
+        if(!gwf.GetChannel(chans[c].name, type, fs)) continue;
+        if(Ogwf::GetTypeSize(type)==0) continue;
+        chans[c].type = type;
+        chans[c].fs = fs;
+        chans[c].n = (long unsigned int)lround((aGpsEnd-aGpsStart)*fs);
+        chans[c].data.assign(chans[c].n*Ogwf::GetTypeSize(type), 0);
+      }
+      long unsigned int n = gwf.Read(chans[c].name, aGpsStart, chans[c].n, chans[c].data.data(), chans[c].type, chans[c].fs);
+      if((n==0)&&(fVerbosity>1)) cout<<"Oframe::Load: no data for "<<chans[c].name<<" in "<<aFiles[f]<<endl;
+      chans[c].loaded += n;
+    }
+  }
+
+  if(fVerbosity>0){
+    for(unsigned int c=0; c<chans.size(); c++)
+      if(chans[c].loaded<chans[c].n||chans[c].n==0)
+        cerr<<"Oframe::Load: "<<chans[c].name<<": "<<chans[c].loaded<<"/"<<chans[c].n<<" samples loaded"<<endl;
+  }
+  return nfiles;
+}
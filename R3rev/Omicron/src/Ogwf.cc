@@ -0,0 +1,422 @@
+/**
+ * @file 
+ * @brief See Ogwf.h
+ */
+#include "Ogwf.h"
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+////////////////////////////////////////////////////////////////////////////////////
+Ogwf::Ogwf(const string aFilePath, const unsigned int aVerbosity){
+////////////////////////////////////////////////////////////////////////////////////
+  fVerbosity = aVerbosity;
+  filepath = aFilePath;
+  map = NULL;
+  map_size = 0;
+  status = false;
+
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if(fd<0){
+    cerr<<"Ogwf::Ogwf: cannot open "<<filepath<<endl;
+    return;
+  }
+  struct stat st;
+  if((fstat(fd, &st)==0)&&(st.st_size>(off_t)header_size)){
+    void *m = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if(m!=MAP_FAILED){
+      map = (const char*)m;
+      map_size = st.st_size;
+    }
+  }
+  close(fd);
+  if(map==NULL){
+    cerr<<"Ogwf::Ogwf: cannot map "<<filepath<<endl;
+    return;
+  }
+
+  status = MakeIndex();
+  if(fVerbosity>1) cout<<"Ogwf::Ogwf: "<<filepath<<": "<<vects.size()<<" data vectors"<<endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Ogwf::~Ogwf(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(map!=NULL) munmap((void*)map, map_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Ogwf::GetTypeSize(const OgwfType aType){
+////////////////////////////////////////////////////////////////////////////////////
+  switch(aType){
+  case ogwf_type_int16: return 2;
+  case ogwf_type_real4: return 4;
+  case ogwf_type_int32: return 4;
+  case ogwf_type_real8: return 8;
+  default: return 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Ogwf::GetChannel(const string aChannelName, OgwfType &aType, double &aSamplingFrequency){
+////////////////////////////////////////////////////////////////////////////////////
+  vector<Vect>::const_iterator it = lower_bound(vects.begin(), vects.end(), aChannelName, VectBefore);
+  if((it==vects.end())||(it->name.compare(aChannelName))) return false;
+  aType = it->type;
+  aSamplingFrequency = 1.0/it->dx;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+long unsigned int Ogwf::Read(const string aChannelName, const double aGpsStart,
+                             const long unsigned int aSize, void *aBuffer,
+                             const OgwfType aType, const double aSamplingFrequency){
+////////////////////////////////////////////////////////////////////////////////////
+  if(!status) return 0;
+  unsigned int tsize = GetTypeSize(aType);
+  if(tsize==0) return 0;
+
+  long unsigned int n = 0;
+  for(vector<Vect>::const_iterator it = lower_bound(vects.begin(), vects.end(), aChannelName, VectBefore);
+      (it!=vects.end())&&(!it->name.compare(aChannelName)); ++it){
+    if(it->type!=aType) return 0;
+    if(fabs(aSamplingFrequency*it->dx-1.0)>1e-9) return 0;
+
+    // overlap in samples
+    long int v0 = lround((it->start-aGpsStart)*aSamplingFrequency);
+    long int i0 = max(v0, 0L);
+    long int i1 = min(v0+(long int)it->ndata, (long int)aSize);
+    if(i1<=i0) continue;
+
+    if(!Decode(*it, (long unsigned int)(i0-v0), (long unsigned int)(i1-i0), tsize, (char*)aBuffer+i0*tsize)){
+      cerr<<"Ogwf::Read: cannot decode "<<aChannelName<<" in "<<filepath<<endl;
+      return 0;
+    }
+    n += (long unsigned int)(i1-i0);
+  }
+  return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Ogwf::GetVectors(const string aChannelName, const double aGpsStart, const double aGpsEnd,
+                              vector<unsigned int> &aVectors){
+////////////////////////////////////////////////////////////////////////////////////
+  aVectors.clear();
+  for(vector<Vect>::const_iterator it = lower_bound(vects.begin(), vects.end(), aChannelName, VectBefore);
+      (it!=vects.end())&&(!it->name.compare(aChannelName)); ++it){
+    if((it->start<aGpsEnd)&&(it->start+(double)it->ndata*it->dx>aGpsStart)) aVectors.push_back(it-vects.begin());
+  }
+  return aVectors.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Ogwf::DecodeVector(const unsigned int aVectorIndex, void *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int tsize = GetTypeSize(vects[aVectorIndex].type);
+  if(tsize==0) return false;
+  return Decode(vects[aVectorIndex], 0, vects[aVectorIndex].ndata, tsize, (char*)aOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Ogwf::VectBefore(const Vect &aV, const string &aName){
+////////////////////////////////////////////////////////////////////////////////////
+return aV.name.compare(aName)<0; 
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Ogwf::VectLess(const Vect &aV1, const Vect &aV2){
+////////////////////////////////////////////////////////////////////////////////////
+  int c = aV1.name.compare(aV2.name);
+  if(c) return c<0;
+  return aV1.start<aV2.start;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double Ogwf::GetNumber(const long unsigned int aOffset, const Element &aElement){
+////////////////////////////////////////////////////////////////////////////////////
+  const char *p = map+aOffset;
+  if(aElement.real){
+    if(aElement.size==4){ float v; memcpy(&v, p, 4); return v; }
+    double v; memcpy(&v, p, 8); return v;
+  }
+  switch(aElement.size){
+  case 1: return aElement.sign ? (double)(signed char)p[0] : (double)(unsigned char)p[0];
+  case 2: { unsigned short v; memcpy(&v, p, 2); return aElement.sign ? (double)(short)v : (double)v; }
+  case 4: { unsigned int v; memcpy(&v, p, 4); return aElement.sign ? (double)(int)v : (double)v; }
+  default: { long unsigned int v; memcpy(&v, p, 8); return aElement.sign ? (double)(long int)v : (double)v; }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+long unsigned int Ogwf::GetString(const long unsigned int aOffset, const long unsigned int aEnd, string &aString){
+////////////////////////////////////////////////////////////////////////////////////
+  if(aOffset+2>aEnd) return 0;
+  unsigned short l;
+  memcpy(&l, map+aOffset, 2);
+  if(aOffset+2+l>aEnd) return 0;
+  aString.assign(map+aOffset+2, l>0 ? l-1 : 0);
+  return aOffset+2+l;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Ogwf::Element Ogwf::MakeElement(const string aName, const string aType){
+////////////////////////////////////////////////////////////////////////////////////
+  Element e;
+  e.name = aName;
+  e.kind = 0;
+  e.size = 0;
+  e.real = false;
+  e.sign = false;
+  string base = aType;
+  size_t b = aType.find('[');
+  if(b!=string::npos){
+    base = aType.substr(0, b);
+    e.count = aType.substr(b+1, aType.find(']', b)-b-1);
+  }
+  if(!base.compare(0, 10, "PTR_STRUCT")) e.kind = 2;
+  else if(!base.compare("STRING")) e.kind = 1;
+  else{
+    if(!base.compare("CHAR")){ e.size = 1; e.sign = true; }
+    else if(!base.compare("CHAR_U")) e.size = 1;
+    else if(!base.compare(0, 4, "INT_")){
+      e.size = base[4]-'0';
+      e.sign = (base[5]=='S');
+    }
+    else if(!base.compare(0, 5, "REAL_")){
+      e.size = base[5]-'0';
+      e.real = true;
+    }
+    else if(!base.compare(0, 8, "COMPLEX_")){
+      e.size = atoi(base.c_str()+8);
+      e.real = true;
+    }
+  }
+  if(!e.count.empty()) e.kind = (e.kind==1) ? 4 : 3;
+  return e;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Ogwf::Parse(const vector<Element> &aElements, long unsigned int aOffset, const long unsigned int aEnd, Values &aValues){
+////////////////////////////////////////////////////////////////////////////////////
+  aValues.name.clear();
+  aValues.num.clear();
+  aValues.ptr.clear();
+  aValues.arr.clear();
+  string s;
+  for(unsigned int e=0; e<aElements.size(); e++){
+    const Element &el = aElements[e];
+
+    // array size
+    long unsigned int n = 1;
+    if(el.kind>=3){
+      if(isdigit(el.count[0])) n = strtoul(el.count.c_str(), NULL, 10);
+      else{
+        std::map<string, double>::const_iterator c = aValues.num.find(el.count);
+        if(c==aValues.num.end()) return;
+        n = (long unsigned int)c->second;
+      }
+    }
+
+    if((el.kind==1)||(el.kind==4)){
+      for(long unsigned int i=0; i<n; i++){
+        aOffset = GetString(aOffset, aEnd, s);
+        if(aOffset==0) return;
+        if((el.kind==1)&&aValues.name.empty()&&!el.name.compare("name")) aValues.name = s;
+      }
+    }
+    else if(el.kind==2){
+      if(aOffset+6>aEnd) return;
+      unsigned int inst;
+      memcpy(&inst, map+aOffset+2, 4);
+      aValues.ptr[el.name] = inst;
+      aOffset += 6;
+    }
+    else{
+      if(el.size==0) return;
+      if(aOffset+n*el.size>aEnd) return;
+      if(el.kind==3) aValues.arr[el.name] = aOffset;
+      if(n>0) aValues.num[el.name] = GetNumber(aOffset, el);
+      aOffset += n*el.size;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Ogwf::MakeIndex(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(memcmp(map, "IGWD", 5)){
+    cerr<<"Ogwf::MakeIndex: "<<filepath<<" is not a frame file"<<endl;
+    return false;
+  }
+  if((unsigned char)map[5]<8){
+    cerr<<"Ogwf::MakeIndex: frame format version "<<(unsigned int)(unsigned char)map[5]<<" is not supported"<<endl;
+    return false;
+  }
+  unsigned short order;
+  memcpy(&order, map+12, 2);
+  if((order!=0x1234)||(map[7]!=2)||(map[8]!=4)||(map[9]!=8)||(map[10]!=4)||(map[11]!=8)){
+    cerr<<"Ogwf::MakeIndex: the byte order or the type sizes of "<<filepath<<" are not supported"<<endl;
+    return false;
+  }
+
+  vector< vector<Element> > dict(256);  // dictionary / class
+  vector<string> classname(256);
+  int cur = -1;                         // class described by the last FrSH
+
+  Values val;
+  string s, comment;
+  double frame_time = 0.0;
+  std::map<unsigned int, double> chan_offset;  // vector instance --> time offset
+  std::map<unsigned int, Vect> frame_vects;    // vector instance --> vector
+
+  long unsigned int pos = header_size;
+  while(pos+struct_size<=map_size){
+    long unsigned int length;
+    memcpy(&length, map+pos, 8);
+    if((length<struct_size)||(pos+length>map_size)){
+      cerr<<"Ogwf::MakeIndex: corrupted structure in "<<filepath<<endl;
+      return false;
+    }
+    unsigned char cl = map[pos+9];
+    unsigned int inst;
+    memcpy(&inst, map+pos+10, 4);
+    long unsigned int body = pos+struct_size, end = pos+length;
+
+    // dictionary header
+    if(cl==1){
+      long unsigned int p = GetString(body, end, s);
+      if((p==0)||(p+2>end)) return false;
+      unsigned short id;
+      memcpy(&id, map+p, 2);
+      cur = -1;
+      if(id<256){
+        cur = id;
+        classname[cur] = s;
+        dict[cur].clear();
+      }
+    }
+
+    // dictionary element
+    else if(cl==2){
+      long unsigned int p = GetString(body, end, s);
+      if((p!=0)&&(cur>=0)&&GetString(p, end, comment)) dict[cur].push_back(MakeElement(s, comment));
+    }
+
+    // frame header
+    else if(!classname[cl].compare("FrameH")){
+      AddVectors(frame_vects, chan_offset, frame_time);
+      Parse(dict[cl], body, end, val);
+      frame_time = val.num["GTimeS"]+1.0e-9*val.num["GTimeN"];
+    }
+
+    // channels
+    else if(!classname[cl].compare("FrAdcData")||!classname[cl].compare("FrProcData")||!classname[cl].compare("FrSimData")){
+      Parse(dict[cl], body, end, val);
+      std::map<string, unsigned int>::const_iterator d = val.ptr.find("data");
+      if(d!=val.ptr.end()) chan_offset[d->second] = val.num["timeOffset"];
+    }
+
+    // data vectors
+    else if(!classname[cl].compare("FrVect")){
+      Parse(dict[cl], body, end, val);
+      if(val.arr.count("data")&&val.num.count("startX")&&val.num.count("dx")&&(val.num["nDim"]==1)){
+        Vect v;
+        v.name = val.name;
+        v.start = val.num["startX"];
+        v.dx = val.num["dx"];
+        v.ndata = (long unsigned int)val.num["nData"];
+        v.compress = (unsigned short)val.num["compress"];
+        v.type = (OgwfType)(unsigned int)val.num["type"];
+        if(!GetTypeSize(v.type)) v.type = ogwf_type_unknown;
+        v.offset = val.arr["data"];
+        v.nbytes = (long unsigned int)val.num["nBytes"];
+        if(v.dx>0.0) frame_vects[inst] = v;
+      }
+    }
+
+    // end of frame
+    else if(!classname[cl].compare("FrEndOfFrame")) AddVectors(frame_vects, chan_offset, frame_time);
+
+    pos = end;
+  }
+  AddVectors(frame_vects, chan_offset, frame_time);
+
+  sort(vects.begin(), vects.end(), VectLess);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Ogwf::AddVectors(std::map<unsigned int, Vect> &aVects, std::map<unsigned int, double> &aOffsets, const double aFrameTime){
+////////////////////////////////////////////////////////////////////////////////////
+  for(std::map<unsigned int, double>::const_iterator o=aOffsets.begin(); o!=aOffsets.end(); ++o){
+    std::map<unsigned int, Vect>::iterator v = aVects.find(o->first);
+    if(v==aVects.end()) continue;
+    v->second.start += aFrameTime+o->second;
+    vects.push_back(v->second);
+  }
+  aVects.clear();
+  aOffsets.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Ogwf::Decode(const Vect &aVect, const long unsigned int aFirst, const long unsigned int aN,
+                  const unsigned int aTypeSize, char *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int scheme = aVect.compress&0xff;
+
+  // uncompressed: copy from the mapped file
+  if(scheme==0){
+    if(aVect.nbytes<aVect.ndata*aTypeSize) return false;
+    memcpy(aOut, map+aVect.offset+aFirst*aTypeSize, aN*aTypeSize);
+    return true;
+  }
+
+  // gzip: GZIP (1), GZIP in version 9 (2), ZERO_SUPPRESS_OTHERWISE_GZIP for floating-point types (6)
+  bool gzip = (scheme==1)||(scheme==2)||((scheme==6)&&((aVect.type==ogwf_type_real4)||(aVect.type==ogwf_type_real8)));
+  if(!gzip) return false;
+
+  z_stream z;
+  memset(&z, 0, sizeof(z_stream));
+  if(inflateInit(&z)!=Z_OK) return false;
+  z.next_in = (Bytef*)(map+aVect.offset);
+  long unsigned int in_left = aVect.nbytes;
+
+  // skip the first samples, then inflate in the output buffer
+  unsigned char skip[16384];
+  long unsigned int skip_left = aFirst*aTypeSize, out_left = aN*aTypeSize;
+  char *out = aOut;
+  int ret = Z_OK;
+  while(out_left>0){
+    if(z.avail_in==0){
+      z.avail_in = (uInt)min(in_left, (long unsigned int)(1U<<30));
+      in_left -= z.avail_in;
+    }
+    long unsigned int have;
+    if(skip_left>0){
+      z.next_out = skip;
+      z.avail_out = (uInt)min(skip_left, (long unsigned int)sizeof(skip));
+    }
+    else{
+      z.next_out = (Bytef*)out;
+      z.avail_out = (uInt)min(out_left, (long unsigned int)(1U<<30));
+    }
+    have = z.avail_out;
+    ret = inflate(&z, Z_NO_FLUSH);
+    have -= z.avail_out;
+    if(skip_left>0) skip_left -= have;
+    else{
+      out += have;
+      out_left -= have;
+    }
+    if((ret!=Z_OK)&&(ret!=Z_STREAM_END)) break;
+    if((ret==Z_STREAM_END)||((have==0)&&(z.avail_in==0)&&(in_left==0))) break;
+  }
+  inflateEnd(&z);
+  return out_left==0;
+}
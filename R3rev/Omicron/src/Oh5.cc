@@ -0,0 +1,185 @@
+/**
+ * @file 
+ * @brief See Oh5.h
+ */
+#include "Oh5.h"
+#include <iostream>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////
+Oh5::Oh5(const string aFilePath, const string aDataset, const unsigned int aVerbosity){
+////////////////////////////////////////////////////////////////////////////////////
+  fVerbosity = aVerbosity;
+  filepath = aFilePath;
+  file = H5I_INVALID_HID;
+  dset = H5I_INVALID_HID;
+  type = ogwf_type_unknown;
+  start = 0.0;
+  dx = 0.0;
+  nsamples = 0;
+
+  // errors are reported by this class
+  ErrorMute mute;
+
+  file = H5Fopen(filepath.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if(file<0){
+    cerr<<"Oh5::Oh5: cannot open "<<filepath<<endl;
+    return;
+  }
+
+  // strain dataset, with a chunk cache for sequential reads
+  hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+  H5Pset_chunk_cache(dapl, 521, O_H5_CHUNK_CACHE, 1.0);
+  dset = H5Dopen2(file, aDataset.c_str(), dapl);
+  H5Pclose(dapl);
+  if(dset<0){
+    cerr<<"Oh5::Oh5: no dataset "<<aDataset<<" in "<<filepath<<endl;
+    return;
+  }
+
+  // size
+  hid_t space = H5Dget_space(dset);
+  hsize_t dims[1] = {0};
+  if(H5Sget_simple_extent_ndims(space)==1) H5Sget_simple_extent_dims(space, dims, NULL);
+  H5Sclose(space);
+  nsamples = dims[0];
+
+  // native type
+  hid_t t = H5Dget_type(dset);
+  if(H5Tget_class(t)==H5T_FLOAT){
+    if(H5Tget_size(t)==4) type = ogwf_type_real4;
+    else if(H5Tget_size(t)==8) type = ogwf_type_real8;
+  }
+  else if((H5Tget_class(t)==H5T_INTEGER)&&(H5Tget_sign(t)==H5T_SGN_2)){
+    if(H5Tget_size(t)==2) type = ogwf_type_int16;
+    else if(H5Tget_size(t)==4) type = ogwf_type_int32;
+  }
+  H5Tclose(t);
+
+  // time
+  if(!ReadAttribute(dset, "Xstart", start)){
+    hid_t d = H5Dopen2(file, "meta/GPSstart", H5P_DEFAULT);
+    if(d>=0){
+      if(H5Dread(d, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &start)<0) start = 0.0;
+      H5Dclose(d);
+    }
+  }
+  ReadAttribute(dset, "Xspacing", dx);
+
+  // detector
+  hid_t d = H5Dopen2(file, "meta/Detector", H5P_DEFAULT);
+  if(d>=0){
+    ReadString(d, detector);
+    H5Dclose(d);
+  }
+
+  if(!GetStatus()) cerr<<"Oh5::Oh5: "<<filepath<<" is not a supported strain file"<<endl;
+  else if(fVerbosity>1) cout<<"Oh5::Oh5: "<<filepath<<": "<<detector<<" "<<(long int)start<<"-"<<(long int)GetEnd()<<" ("<<GetSamplingFrequency()<<" Hz)"<<endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oh5::~Oh5(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(dset>=0) H5Dclose(dset);
+  if(file>=0) H5Fclose(file);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+long unsigned int Oh5::Read(const double aGpsStart, const long unsigned int aSize, void *aBuffer,
+                            const OgwfType aType, const double aSamplingFrequency){
+////////////////////////////////////////////////////////////////////////////////////
+  if(!GetStatus()) return 0;
+  if(aType!=type) return 0;
+  if(fabs(aSamplingFrequency*dx-1.0)>1e-9) return 0;
+  ErrorMute mute;
+
+  // overlap in samples
+  long int v0 = lround((start-aGpsStart)*aSamplingFrequency);
+  long int i0 = max(v0, 0L);
+  long int i1 = min(v0+(long int)nsamples, (long int)aSize);
+  if(i1<=i0) return 0;
+
+  // file and memory selections
+  hsize_t foffset[1] = {(hsize_t)(i0-v0)};
+  hsize_t moffset[1] = {(hsize_t)i0};
+  hsize_t count[1] = {(hsize_t)(i1-i0)};
+  hsize_t msize[1] = {(hsize_t)aSize};
+  hid_t fspace = H5Dget_space(dset);
+  hid_t mspace = H5Screate_simple(1, msize, NULL);
+  H5Sselect_hyperslab(fspace, H5S_SELECT_SET, foffset, NULL, count, NULL);
+  H5Sselect_hyperslab(mspace, H5S_SELECT_SET, moffset, NULL, count, NULL);
+  herr_t status = H5Dread(dset, GetMemoryType(type), mspace, fspace, H5P_DEFAULT, aBuffer);
+  H5Sclose(mspace);
+  H5Sclose(fspace);
+  if(status<0){
+    cerr<<"Oh5::Read: cannot read "<<filepath<<endl;
+    return 0;
+  }
+  return (long unsigned int)(i1-i0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+hid_t Oh5::GetMemoryType(const OgwfType aType){
+////////////////////////////////////////////////////////////////////////////////////
+  switch(aType){
+  case ogwf_type_int16: return H5T_NATIVE_SHORT;
+  case ogwf_type_int32: return H5T_NATIVE_INT;
+  case ogwf_type_real4: return H5T_NATIVE_FLOAT;
+  default: return H5T_NATIVE_DOUBLE;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oh5::ReadAttribute(const hid_t aObject, const string aName, double &aValue){
+////////////////////////////////////////////////////////////////////////////////////
+  if(H5Aexists(aObject, aName.c_str())<=0) return false;
+  hid_t a = H5Aopen(aObject, aName.c_str(), H5P_DEFAULT);
+  if(a<0) return false;
+  bool ok = (H5Aread(a, H5T_NATIVE_DOUBLE, &aValue)>=0);
+  H5Aclose(a);
+  return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oh5::ReadString(const hid_t aDataset, string &aValue){
+////////////////////////////////////////////////////////////////////////////////////
+  hid_t t = H5Dget_type(aDataset);
+  bool ok = false;
+  if(H5Tget_class(t)==H5T_STRING){
+    if(H5Tis_variable_str(t)>0){
+      char *s = NULL;
+      hid_t mt = H5Tcopy(H5T_C_S1);
+      H5Tset_size(mt, H5T_VARIABLE);
+      if(H5Dread(aDataset, mt, H5S_ALL, H5S_ALL, H5P_DEFAULT, &s)>=0){
+        if(s!=NULL) aValue = s;
+        ok = true;
+        H5free_memory(s);
+      }
+      H5Tclose(mt);
+    }
+    else{
+      vector<char> s(H5Tget_size(t)+1, '\0');
+      if(H5Dread(aDataset, t, H5S_ALL, H5S_ALL, H5P_DEFAULT, s.data())>=0){
+        aValue = s.data();
+        ok = true;
+      }
+    }
+  }
+  H5Tclose(t);
+  return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oh5::ErrorMute::ErrorMute(void){
+////////////////////////////////////////////////////////////////////////////////////
+  func = NULL;
+  data = NULL;
+  H5Eget_auto2(H5E_DEFAULT, &func, &data);
+  H5Eset_auto2(H5E_DEFAULT, NULL, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oh5::ErrorMute::~ErrorMute(void){
+////////////////////////////////////////////////////////////////////////////////////
+  H5Eset_auto2(H5E_DEFAULT, func, data);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @brief See Opool.h
+ */
+#include "Opool.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Opool::Opool(const unsigned int aThreadN){
+////////////////////////////////////////////////////////////////////////////////////
+  nthreads = aThreadN;
+  if(nthreads==0) nthreads = thread::hardware_concurrency();
+  if(nthreads==0) nthreads = 1;
+  task_n = 0;
+  task_next = 0;
+  task_done = 0;
+  active = 0;
+  generation = 0;
+  stop = false;
+  for(unsigned int t=1; t<nthreads; t++) workers.push_back(thread(&Opool::Work, this, t));
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Opool::~Opool(void){
+////////////////////////////////////////////////////////////////////////////////////
+  {
+    lock_guard<mutex> lock(mtx);
+    stop = true;
+  }
+  cv_start.notify_all();
+  for(unsigned int t=0; t<workers.size(); t++) workers[t].join();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Opool::Run(const unsigned int aTaskN, function<void(const unsigned int, const unsigned int)> aTask){
+////////////////////////////////////////////////////////////////////////////////////
+  if(aTaskN==0) return;
+
+  // sequential
+  if(nthreads==1){
+    for(unsigned int i=0; i<aTaskN; i++) aTask(i, 0);
+    return;
+  }
+
+  // start workers (after the previous list is fully released)
+  {
+    unique_lock<mutex> lock(mtx);
+    cv_done.wait(lock, [this]{ return active==0; });
+    task = aTask;
+    task_n = aTaskN;
+    task_next = 0;
+    task_done = 0;
+    generation++;
+  }
+  cv_start.notify_all();
+
+  // the calling thread works too
+  RunTasks(0);
+
+  // wait for completion
+  unique_lock<mutex> lock(mtx);
+  cv_done.wait(lock, [this]{ return (task_done==task_n)&&(active==0); });
+  task = nullptr;
+  return;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Opool::RunTasks(const unsigned int aThreadIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int ndone = 0;
+  for(unsigned int i=task_next++; i<task_n; i=task_next++){
+    task(i, aThreadIndex);
+    ndone++;
+  }
+  lock_guard<mutex> lock(mtx);
+  task_done += ndone;
+  if(aThreadIndex>0) active--;
+  cv_done.notify_all();
+  return;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Opool::Work(const unsigned int aThreadIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned long int gen = 0;
+  while(true){
+    {
+      unique_lock<mutex> lock(mtx);
+      cv_start.wait(lock, [this, gen]{ return stop||(generation!=gen); });
+      if(stop) return;
+      gen = generation;
+      active++;
+    }
+    RunTasks(aThreadIndex);
+  }
+}
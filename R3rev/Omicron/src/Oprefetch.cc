@@ -0,0 +1,132 @@
+/**
+ * @file 
+ * @brief See Oprefetch.h
+ */
+#include "Oprefetch.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Oprefetch::Oprefetch(OprefetchLoader aLoader, const long unsigned int aMemoryBudget){
+////////////////////////////////////////////////////////////////////////////////////
+  loader = aLoader;
+  budget = aMemoryBudget;
+  used = 0;
+  generation = 0;
+  stop = false;
+  busy = false;
+  worker = thread(&Oprefetch::Work, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oprefetch::~Oprefetch(void){
+////////////////////////////////////////////////////////////////////////////////////
+  {
+    lock_guard<mutex> lock(mtx);
+    stop = true;
+  }
+  cv.notify_all();
+  worker.join();
+  Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Oprefetch::Request(const unsigned int aTimeStart, const unsigned int aTimeEnd,
+                        const vector<unsigned int> &aChannels){
+////////////////////////////////////////////////////////////////////////////////////
+  {
+    lock_guard<mutex> lock(mtx);
+    for(unsigned int c=0; c<aChannels.size(); c++){
+      Key k = make_tuple(aTimeStart, aTimeEnd, aChannels[c]);
+      if(data.count(k)||IsPending(k)) continue;
+      pending.push_back(k);
+    }
+  }
+  cv.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oprefetch::Get(const unsigned int aTimeStart, const unsigned int aTimeEnd, const unsigned int aChannel,
+                    double **aData, unsigned int &aSize){
+////////////////////////////////////////////////////////////////////////////////////
+  *aData = NULL;
+  aSize = 0;
+  Key k = make_tuple(aTimeStart, aTimeEnd, aChannel);
+  unique_lock<mutex> lock(mtx);
+  cv.wait(lock, [this, &k]{ return data.count(k)||(!IsPending(k)&&!(busy&&(current==k))); });
+  map<Key, Vect>::iterator it = data.find(k);
+  if(it==data.end()) return false;
+  *aData = it->second.first;
+  aSize = it->second.second;
+  used -= (long unsigned int)aSize*sizeof(double);
+  data.erase(it);
+  lock.unlock();
+  cv.notify_all();
+  return (*aData!=NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Oprefetch::Cancel(void){
+////////////////////////////////////////////////////////////////////////////////////
+  {
+    lock_guard<mutex> lock(mtx);
+    pending.clear();
+    generation++;
+  }
+  Clear();
+  cv.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oprefetch::IsPending(const Key &aKey){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int i=0; i<pending.size(); i++) if(pending[i]==aKey) return true;
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Oprefetch::Clear(void){
+////////////////////////////////////////////////////////////////////////////////////
+  lock_guard<mutex> lock(mtx);
+  for(map<Key, Vect>::iterator it=data.begin(); it!=data.end(); ++it)
+    if(it->second.first!=NULL) delete [] it->second.first;
+  data.clear();
+  used = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Oprefetch::Work(void){
+////////////////////////////////////////////////////////////////////////////////////
+  while(true){
+    long unsigned int gen;
+    {
+      unique_lock<mutex> lock(mtx);
+      cv.wait(lock, [this]{ return stop||(!pending.empty()&&used<budget); });
+      if(stop) return;
+      current = pending.front();
+      pending.pop_front();
+      busy = true;
+      gen = generation;
+    }
+
+    // load (unlocked)
+    double *v = NULL;
+    unsigned int n = 0;
+    if(!loader(get<0>(current), get<1>(current), get<2>(current), &v, n)){
+      if(v!=NULL) delete [] v;
+      v = NULL;
+      n = 0;
+    }
+
+    {
+      lock_guard<mutex> lock(mtx);
+      busy = false;
+      if(gen!=generation){// canceled
+        if(v!=NULL) delete [] v;
+      }
+      else{
+        data[current] = make_pair(v, n);
+        used += (long unsigned int)n*sizeof(double);
+      }
+    }
+    cv.notify_all();
+  }
+}
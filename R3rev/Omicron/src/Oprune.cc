@@ -0,0 +1,75 @@
+/**
+ * @file 
+ * @brief See Oprune.h
+ */
+#include "Oprune.h"
+#include <cstring>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////////
+Oprune::Oprune(const unsigned int aSize, const unsigned int aBlockN){
+////////////////////////////////////////////////////////////////////////////////////
+  size = aSize>0 ? aSize : 1;
+  blockn = aBlockN>0 ? aBlockN : 1;
+  blocksize = size/blockn;
+  in = NULL;
+  stage = NULL;
+  twiddle = NULL;
+  plan = NULL;
+  if((blocksize==0)||(size%blockn)) return;
+
+  in = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*size);
+  stage = (fftw_complex*)fftw_malloc(sizeof(fftw_complex)*size);
+  twiddle = new double [2*size];
+  for(unsigned int j=0; j<size; j++){
+    twiddle[2*j]   = cos(2.0*M_PI*(double)j/(double)size);
+    twiddle[2*j+1] = sin(2.0*M_PI*(double)j/(double)size);
+  }
+
+  // first stage: M transforms of size L, input stride M, contiguous output rows
+  int n[1] = {(int)blocksize};
+  plan = fftw_plan_many_dft(1, n, (int)blockn,
+                            in, NULL, (int)blockn, 1,
+                            stage, NULL, 1, (int)blocksize,
+                            FFTW_BACKWARD, FFTW_ESTIMATE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oprune::~Oprune(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(plan!=NULL) fftw_destroy_plan(plan);
+  if(in!=NULL) fftw_free(in);
+  if(stage!=NULL) fftw_free(stage);
+  delete [] twiddle;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oprune::Transform(const fftw_complex *aIn, const unsigned int aFirstBlock, const unsigned int aLastBlock,
+                       fftw_complex *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  if(plan==NULL) return false;
+  if((aFirstBlock>aLastBlock)||(aLastBlock>blockn)) return false;
+  if(aFirstBlock==aLastBlock) return true;
+
+  // first stage
+  memcpy(in, aIn, sizeof(fftw_complex)*size);
+  fftw_execute(plan);
+
+  // second stage: requested samples only
+  long unsigned int j;
+  double re, im;
+  for(unsigned int n=aFirstBlock*blocksize; n<aLastBlock*blocksize; n++){
+    unsigned int n1 = n%blocksize;
+    re = 0.0;
+    im = 0.0;
+    j = 0;// (k2 x n) mod N
+    for(unsigned int k2=0; k2<blockn; k2++){
+      re += stage[k2*blocksize+n1][0]*twiddle[2*j]-stage[k2*blocksize+n1][1]*twiddle[2*j+1];
+      im += stage[k2*blocksize+n1][0]*twiddle[2*j+1]+stage[k2*blocksize+n1][1]*twiddle[2*j];
+      j = (j+n)%size;
+    }
+    aOut[n-aFirstBlock*blocksize][0] = re;
+    aOut[n-aFirstBlock*blocksize][1] = im;
+  }
+  return true;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file 
+ * @brief See Opsd.h
+ */
+#include "Opsd.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Omedian::Omedian(const unsigned int aWindowN){
+////////////////////////////////////////////////////////////////////////////////////
+  SetWindowN(aWindowN);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Omedian::~Omedian(void){
+////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Omedian::SetWindowN(const unsigned int aWindowN){
+////////////////////////////////////////////////////////////////////////////////////
+  ring.assign(aWindowN>0 ? aWindowN : 1, 0.0);
+  Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Omedian::Reset(void){
+////////////////////////////////////////////////////////////////////////////////////
+  lo.clear();
+  hi.clear();
+  ring_next = 0;
+  n = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Omedian::Add(const double aValue){
+////////////////////////////////////////////////////////////////////////////////////
+  // remove oldest value
+  if(n==ring.size()){
+    double old = ring[ring_next];
+    multiset<double>::iterator it = lo.find(old);
+    if(it!=lo.end()) lo.erase(it);
+    else hi.erase(hi.find(old));
+    n--;
+  }
+  ring[ring_next] = aValue;
+  ring_next = (ring_next+1)%ring.size();
+  n++;
+
+  // insert new value
+  if(lo.empty()||(aValue<=*lo.rbegin())) lo.insert(aValue);
+  else hi.insert(aValue);
+
+  // re-balance: lo.size() = hi.size() or hi.size()+1
+  while(lo.size()>hi.size()+1){
+    hi.insert(*lo.rbegin());
+    lo.erase(prev(lo.end()));
+  }
+  while(hi.size()>lo.size()){
+    lo.insert(*hi.begin());
+    hi.erase(hi.begin());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double Omedian::GetMedian(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(lo.size()>hi.size()) return *lo.rbegin();
+  return (*lo.rbegin()+*hi.begin())/2.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Opsd::Opsd(const unsigned int aSamplingFrequency, const unsigned int aSegmentSize, const unsigned int aWindowN){
+////////////////////////////////////////////////////////////////////////////////////
+  fs = aSamplingFrequency;
+  nseg = aSegmentSize+aSegmentSize%2;
+  nbins = nseg/2+1;
+  nwin = TMath::Max(aWindowN, (unsigned int)1);
+
+  median = new Omedian [nbins];
+  for(unsigned int k=0; k<nbins; k++) median[k].SetWindowN(nwin);
+
+  // Hann window
+  hann = new double [nseg];
+  double sumsq = 0.0;
+  for(unsigned int i=0; i<nseg; i++){
+    hann[i] = 0.5-0.5*TMath::Cos(2.0*TMath::Pi()*(double)i/(double)nseg);
+    sumsq += hann[i]*hann[i];
+  }
+  norm = 2.0/((double)fs*sumsq);
+
+  // median bias
+  bias = MedianBias(nwin);
+
+  segment = (double*)fftw_malloc(nseg*sizeof(double));
+  segment_f = (fftw_complex*)fftw_malloc(nbins*sizeof(fftw_complex));
+  plan = fftw_plan_dft_r2c_1d(nseg, segment, segment_f, FFTW_ESTIMATE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Opsd::~Opsd(void){
+////////////////////////////////////////////////////////////////////////////////////
+  fftw_destroy_plan(plan);
+  fftw_free(segment);
+  fftw_free(segment_f);
+  delete [] median;
+  delete [] hann;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Opsd::Reset(void){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int k=0; k<nbins; k++) median[k].Reset();
+  bias = MedianBias(nwin);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Opsd::AddData(const unsigned int aN, const double *aData){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int np = 0;
+  for(unsigned int i0=0; i0+nseg<=aN; i0+=nseg/2){
+    for(unsigned int i=0; i<nseg; i++) segment[i] = aData[i0+i]*hann[i];
+    fftw_execute(plan);
+    for(unsigned int k=0; k<nbins; k++)
+      segment[k] = norm*(segment_f[k][0]*segment_f[k][0]+segment_f[k][1]*segment_f[k][1]);
+    segment[0] /= 2.0;
+    segment[nbins-1] /= 2.0;
+    AddPeriodogram(segment);
+    np++;
+  }
+  return np;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Opsd::AddPeriodogram(const double *aPeriodogram){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int k=0; k<nbins; k++) median[k].Add(aPeriodogram[k]);
+  bias = MedianBias(median[0].GetN());
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double Opsd::GetPower(const double aFrequency){
+////////////////////////////////////////////////////////////////////////////////////
+  double x = aFrequency/GetFrequencyResolution();
+  if((x<0.0)||(x>(double)(nbins-1))) return 0.0;
+  unsigned int k = (unsigned int)x;
+  if(k==nbins-1) return GetPower(k);
+  return GetPower(k)+(x-(double)k)*(GetPower(k+1)-GetPower(k));
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double Opsd::MedianBias(const unsigned int aN){
+////////////////////////////////////////////////////////////////////////////////////
+  double b = 0.0;
+  unsigned int n = aN+1-aN%2;
+  for(unsigned int i=1; i<=n; i++) b += ((i%2) ? 1.0 : -1.0)/(double)i;
+  return b;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file 
+ * @brief See Oring.h
+ */
+#include "Oring.h"
+
+////////////////////////////////////////////////////////////////////////////////////
+Oring::Oring(const unsigned int aSamplingFrequency, const unsigned int aDuration){
+////////////////////////////////////////////////////////////////////////////////////
+  fs = aSamplingFrequency;
+  capacity = (long unsigned int)fs*(long unsigned int)aDuration;
+  ring = new double [capacity>0 ? capacity : 1];
+  Reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oring::~Oring(void){
+////////////////////////////////////////////////////////////////////////////////////
+  delete [] ring;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oring::GetMissing(const unsigned int aTimeStart, const unsigned int aTimeEnd,
+                       unsigned int &aReadStart, unsigned int &aReadEnd){
+////////////////////////////////////////////////////////////////////////////////////
+  aReadEnd = aTimeEnd;
+  if(Contains(aTimeStart, aTimeEnd)){
+    aReadStart = aTimeEnd;
+    return false;
+  }
+  if((aTimeStart>=ts)&&(aTimeStart<te)) aReadStart = te;
+  else aReadStart = aTimeStart;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Oring::Put(const unsigned int aTimeStart, const unsigned int aTimeEnd, const double *aData){
+////////////////////////////////////////////////////////////////////////////////////
+  if((aTimeEnd<=aTimeStart)||(capacity==0)) return;
+  if((aTimeStart!=te)||(te==ts)){
+    ts = aTimeStart;
+    te = aTimeStart;
+    head = 0;
+  }
+
+  long unsigned int n = (long unsigned int)(aTimeEnd-aTimeStart)*(long unsigned int)fs;
+  const double *d = aData;
+  if(n>capacity){// only keep the last samples
+    d += n-capacity;
+    n = capacity;
+    ts = aTimeEnd-(unsigned int)(capacity/fs);
+    te = ts;
+    head = 0;
+  }
+
+  long unsigned int tail = (head+GetSize())%capacity;
+  long unsigned int n1 = capacity-tail < n ? capacity-tail : n;
+  memcpy(ring+tail, d, n1*sizeof(double));
+  memcpy(ring, d+n1, (n-n1)*sizeof(double));
+
+  te = aTimeEnd;
+  if((long unsigned int)(te-ts)*(long unsigned int)fs>capacity){
+    unsigned int tsnew = te-(unsigned int)(capacity/fs);
+    head = (head+(long unsigned int)(tsnew-ts)*(long unsigned int)fs)%capacity;
+    ts = tsnew;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oring::Read(const unsigned int aTimeStart, const unsigned int aTimeEnd, double *aData){
+////////////////////////////////////////////////////////////////////////////////////
+  if(!Contains(aTimeStart, aTimeEnd)) return false;
+  long unsigned int n = (long unsigned int)(aTimeEnd-aTimeStart)*(long unsigned int)fs;
+  long unsigned int i0 = (head+(long unsigned int)(aTimeStart-ts)*(long unsigned int)fs)%capacity;
+  long unsigned int n1 = capacity-i0 < n ? capacity-i0 : n;
+  memcpy(aData, ring+i0, n1*sizeof(double));
+  memcpy(aData+n1, ring, (n-n1)*sizeof(double));
+  return true;
+}
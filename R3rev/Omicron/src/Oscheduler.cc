@@ -0,0 +1,147 @@
+/**
+ * @file 
+ * @brief See Oscheduler.h
+ */
+#include "Oscheduler.h"
+#include <cstdio>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+////////////////////////////////////////////////////////////////////////////////////
+Oscheduler::Oscheduler(const unsigned int aWorkerN){
+////////////////////////////////////////////////////////////////////////////////////
+  nworkers = aWorkerN;
+  if(nworkers==0) nworkers = thread::hardware_concurrency();
+  if(nworkers==0) nworkers = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Oscheduler::~Oscheduler(void){
+////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+unsigned int Oscheduler::AddItem(const double aCost){
+////////////////////////////////////////////////////////////////////////////////////
+  cost.push_back(aCost);
+  return cost.size()-1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double Oscheduler::GetCost(const double aTileN, const double aTriggerRate, const double aTriggerRateMax){
+////////////////////////////////////////////////////////////////////////////////////
+  if(aTriggerRateMax<=0.0) return aTileN;
+  return aTileN*(1.0+aTriggerRate/aTriggerRateMax);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+vector<unsigned int> Oscheduler::RunThreads(function<void(const unsigned int, const unsigned int)> aWork){
+////////////////////////////////////////////////////////////////////////////////////
+  vector<unsigned int> done(nworkers, 0);
+
+  // distribute items: largest first, to the least loaded worker
+  queues.assign(nworkers, deque<unsigned int>());
+  load.assign(nworkers, 0.0);
+  vector<unsigned int> order = GetOrder();
+  for(unsigned int i=0; i<order.size(); i++){
+    unsigned int w = min_element(load.begin(), load.end())-load.begin();
+    queues[w].push_back(order[i]);
+    load[w] += cost[order[i]];
+  }
+  locks = vector<mutex>(nworkers);
+
+  // workers
+  vector<thread> threads;
+  for(unsigned int w=1; w<nworkers; w++)
+    threads.push_back(thread([this, &aWork, &done, w]{ Work(w, aWork, done[w]); }));
+  Work(0, aWork, done[0]);
+  for(unsigned int t=0; t<threads.size(); t++) threads[t].join();
+  return done;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+int Oscheduler::RunProcesses(function<bool(const unsigned int, const unsigned int)> aWork){
+////////////////////////////////////////////////////////////////////////////////////
+  vector<unsigned int> order = GetOrder();
+  atomic<unsigned int> *next = (atomic<unsigned int>*)mmap(NULL, sizeof(atomic<unsigned int>),
+                                                           PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if(next==MAP_FAILED) return -1;
+  new(next) atomic<unsigned int>(0);
+
+  fflush(NULL);// do not duplicate buffered output in the children
+  vector<pid_t> pids;
+  int nfail = 0;
+  for(unsigned int w=0; w<nworkers; w++){
+    pid_t pid = fork();
+    if(pid<0){ nfail = -1; break; }
+    if(pid==0){
+      bool ok = true;
+      for(unsigned int i=(*next)++; i<order.size(); i=(*next)++) ok = aWork(order[i], w)&&ok;
+      _exit(ok ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+
+  int status;
+  for(unsigned int p=0; p<pids.size(); p++){
+    if(waitpid(pids[p], &status, 0)<0) nfail = -1;
+    else if(nfail>=0&&(!WIFEXITED(status)||WEXITSTATUS(status)!=0)) nfail++;
+  }
+  munmap(next, sizeof(atomic<unsigned int>));
+  return nfail;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+vector<unsigned int> Oscheduler::GetOrder(void){
+////////////////////////////////////////////////////////////////////////////////////
+  vector<unsigned int> order(cost.size());
+  for(unsigned int i=0; i<order.size(); i++) order[i] = i;
+  stable_sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b){ return cost[a]>cost[b]; });
+  return order;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Oscheduler::Take(const unsigned int aWorkerIndex, unsigned int &aItem){
+////////////////////////////////////////////////////////////////////////////////////
+  // own queue: front
+  {
+    lock_guard<mutex> lock(locks[aWorkerIndex]);
+    if(!queues[aWorkerIndex].empty()){
+      aItem = queues[aWorkerIndex].front();
+      queues[aWorkerIndex].pop_front();
+      load[aWorkerIndex] -= cost[aItem];
+      return true;
+    }
+  }
+
+  // steal: back of the most loaded queue
+  while(true){
+    unsigned int victim = nworkers;
+    double lmax = -1.0;
+    for(unsigned int w=0; w<nworkers; w++){
+      lock_guard<mutex> lock(locks[w]);
+      if(!queues[w].empty()&&load[w]>lmax){ lmax = load[w]; victim = w; }
+    }
+    if(victim==nworkers) return false;
+    lock_guard<mutex> lock(locks[victim]);
+    if(queues[victim].empty()) continue;// stolen meanwhile
+    aItem = queues[victim].back();
+    queues[victim].pop_back();
+    load[victim] -= cost[aItem];
+    return true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void Oscheduler::Work(const unsigned int aWorkerIndex,
+                      function<void(const unsigned int, const unsigned int)> &aWork,
+                      unsigned int &aDone){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int item;
+  while(Take(aWorkerIndex, item)){
+    aWork(item, aWorkerIndex);
+    aDone++;
+  }
+}
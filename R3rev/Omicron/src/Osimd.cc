@@ -0,0 +1,469 @@
+/**
+ * @file
+ * @brief See Osimd.h
+ */
+#include "Osimd.h"
+
+/**
+ * @brief Register barrier preventing the contraction of a product into a fused multiply-add.
+ * @details The compiler cannot see through the empty assembly statement: the product is rounded before it is added.
+ * This is independent of the `-ffp-contract` option and of the target instruction set.
+ */
+#ifdef __SSE2__
+#define O_SIMD_NOFMA(x) __asm__("" : "+x"(x))
+#else
+#define O_SIMD_NOFMA(x) __asm__("" : "+m"(x))
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindowScalar(const unsigned int aN, const double *aIn,
+                       const double *aWindowRe, const double *aWindowIm, double *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  double re, im, rr, ii, ri, ir;
+  for(unsigned int k=0; k<aN; k++){
+    re = aIn[2*k];
+    im = aIn[2*k+1];
+    rr = re*aWindowRe[k]; O_SIMD_NOFMA(rr);
+    ii = im*aWindowIm[k]; O_SIMD_NOFMA(ii);
+    ri = re*aWindowIm[k]; O_SIMD_NOFMA(ri);
+    ir = im*aWindowRe[k]; O_SIMD_NOFMA(ir);
+    aOut[2*k]   = rr - ii;
+    aOut[2*k+1] = ri + ir;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSqScalar(const unsigned int aN, const double *aZ,
+                        const double aSnrSqThr, long unsigned int &aAboveN,
+                        unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  double snrsq, rr, ii, snrsqmax = 0.0;
+  aAboveN = 0;
+  for(unsigned int k=0; k<aN; k++){
+    rr = aZ[2*k]*aZ[2*k];     O_SIMD_NOFMA(rr);
+    ii = aZ[2*k+1]*aZ[2*k+1]; O_SIMD_NOFMA(ii);
+    snrsq = rr + ii - 2.0;
+    snrsq = (snrsq<0.0) ? 0.0 : snrsq;// NaN is kept: not counted
+    if(snrsq>snrsqmax) snrsqmax = snrsq;
+    if(snrsq>=aSnrSqThr){
+      if(aAboveIndex!=NULL) aAboveIndex[aAboveN] = k;
+      aAboveN++;
+    }
+  }
+  return snrsqmax;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindowScalarF(const unsigned int aN, const double *aIn,
+                        const float *aWindowRe, const float *aWindowIm, float *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  float re, im, rr, ii, ri, ir;
+  for(unsigned int k=0; k<aN; k++){
+    re = (float)aIn[2*k];
+    im = (float)aIn[2*k+1];
+    rr = re*aWindowRe[k]; O_SIMD_NOFMA(rr);
+    ii = im*aWindowIm[k]; O_SIMD_NOFMA(ii);
+    ri = re*aWindowIm[k]; O_SIMD_NOFMA(ri);
+    ir = im*aWindowRe[k]; O_SIMD_NOFMA(ir);
+    aOut[2*k]   = rr - ii;
+    aOut[2*k+1] = ri + ir;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSqScalarF(const unsigned int aN, const float *aZ,
+                         const float aSnrSqThr, long unsigned int &aAboveN,
+                         unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  float snrsq, rr, ii, snrsqmax = 0.0f;
+  aAboveN = 0;
+  for(unsigned int k=0; k<aN; k++){
+    rr = aZ[2*k]*aZ[2*k];     O_SIMD_NOFMA(rr);
+    ii = aZ[2*k+1]*aZ[2*k+1]; O_SIMD_NOFMA(ii);
+    snrsq = rr + ii - 2.0f;
+    snrsq = (snrsq<0.0f) ? 0.0f : snrsq;// NaN is kept: not counted
+    if(snrsq>snrsqmax) snrsqmax = snrsq;
+    if(snrsq>=aSnrSqThr){
+      if(aAboveIndex!=NULL) aAboveIndex[aAboveN] = k;
+      aAboveN++;
+    }
+  }
+  return (double)snrsqmax;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSum8(const double *aS){
+////////////////////////////////////////////////////////////////////////////////////
+  return ((aS[0]+aS[1])+(aS[2]+aS[3]))+((aS[4]+aS[5])+(aS[6]+aS[7]));
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdDotScalar(const unsigned int aN, const double *aA, const double *aB){
+////////////////////////////////////////////////////////////////////////////////////
+  double s[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double p;
+  unsigned int k = 0;
+  for(; k+8<=aN; k+=8){
+    for(unsigned int j=0; j<8; j++){
+      p = aA[k+j]*aB[k+j]; O_SIMD_NOFMA(p);
+      s[j] += p;
+    }
+  }
+  double sum = OsimdSum8(s);
+  for(; k<aN; k++){
+    p = aA[k]*aB[k]; O_SIMD_NOFMA(p);
+    sum += p;
+  }
+  return sum;
+}
+
+#ifdef O_SIMD_X86
+
+__attribute__((target("avx2")))
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindowAvx2(const unsigned int aN, const double *aIn,
+                     const double *aWindowRe, const double *aWindowIm, double *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int k = 0;
+  __m256d x01, x23, re, im, wr, wi, rr, ii, ri, ir, yre, yim, lo, hi;
+  for(; k+4<=aN; k+=4){
+    x01 = _mm256_loadu_pd(aIn+2*k);                   // r0 i0 r1 i1
+    x23 = _mm256_loadu_pd(aIn+2*k+4);                 // r2 i2 r3 i3
+    re  = _mm256_unpacklo_pd(x01, x23);               // r0 r2 r1 r3
+    im  = _mm256_unpackhi_pd(x01, x23);               // i0 i2 i1 i3
+    re  = _mm256_permute4x64_pd(re, 0xD8);            // r0 r1 r2 r3
+    im  = _mm256_permute4x64_pd(im, 0xD8);            // i0 i1 i2 i3
+    wr  = _mm256_loadu_pd(aWindowRe+k);
+    wi  = _mm256_loadu_pd(aWindowIm+k);
+    rr  = _mm256_mul_pd(re, wr); O_SIMD_NOFMA(rr);
+    ii  = _mm256_mul_pd(im, wi); O_SIMD_NOFMA(ii);
+    ri  = _mm256_mul_pd(re, wi); O_SIMD_NOFMA(ri);
+    ir  = _mm256_mul_pd(im, wr); O_SIMD_NOFMA(ir);
+    yre = _mm256_sub_pd(rr, ii);
+    yim = _mm256_add_pd(ri, ir);
+    lo  = _mm256_unpacklo_pd(yre, yim);               // yr0 yi0 yr2 yi2
+    hi  = _mm256_unpackhi_pd(yre, yim);               // yr1 yi1 yr3 yi3
+    _mm256_storeu_pd(aOut+2*k,   _mm256_permute2f128_pd(lo, hi, 0x20));
+    _mm256_storeu_pd(aOut+2*k+4, _mm256_permute2f128_pd(lo, hi, 0x31));
+  }
+  OsimdWindowScalar(aN-k, aIn+2*k, aWindowRe+k, aWindowIm+k, aOut+2*k);
+}
+
+__attribute__((target("avx2")))
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSqAvx2(const unsigned int aN, const double *aZ,
+                      const double aSnrSqThr, long unsigned int &aAboveN,
+                      unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  const unsigned int lane[4] = {0, 2, 1, 3};        // tile -> mask bit
+  unsigned int k = 0;
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d thr = _mm256_set1_pd(aSnrSqThr);
+  __m256d vmax = zero;
+  __m256d z01, z23, sq01, sq23, snrsq;
+  long unsigned int n = 0;
+  int mask;
+  for(; k+4<=aN; k+=4){
+    z01   = _mm256_loadu_pd(aZ+2*k);
+    z23   = _mm256_loadu_pd(aZ+2*k+4);
+    sq01  = _mm256_mul_pd(z01, z01);                  // r0^2 i0^2 r1^2 i1^2
+    sq23  = _mm256_mul_pd(z23, z23);                  // r2^2 i2^2 r3^2 i3^2
+    O_SIMD_NOFMA(sq01);
+    O_SIMD_NOFMA(sq23);
+    snrsq = _mm256_sub_pd(_mm256_hadd_pd(sq01, sq23), two);// 0 2 1 3
+    snrsq = _mm256_max_pd(zero, snrsq);               // NaN is kept
+    vmax  = _mm256_max_pd(snrsq, vmax);               // NaN is ignored
+    mask  = _mm256_movemask_pd(_mm256_cmp_pd(snrsq, thr, _CMP_GE_OQ));
+    if(mask==0) continue;
+    if(aAboveIndex==NULL) n += __builtin_popcount(mask);
+    else for(unsigned int j=0; j<4; j++) if(mask&(1<<lane[j])) aAboveIndex[n++] = k+j;
+  }
+  double m[4];
+  _mm256_storeu_pd(m, vmax);
+  long unsigned int ntail;
+  double snrsqmax = OsimdSnrSqScalar(aN-k, aZ+2*k, aSnrSqThr, ntail, aAboveIndex==NULL ? NULL : aAboveIndex+n);
+  if(aAboveIndex!=NULL) for(unsigned int j=0; j<ntail; j++) aAboveIndex[n+j] += k;
+  for(unsigned int j=0; j<4; j++) if(m[j]>snrsqmax) snrsqmax = m[j];
+  aAboveN = n+ntail;
+  return snrsqmax;
+}
+
+__attribute__((target("avx2")))
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdDotAvx2(const unsigned int aN, const double *aA, const double *aB){
+////////////////////////////////////////////////////////////////////////////////////
+  __m256d s0 = _mm256_setzero_pd();
+  __m256d s1 = _mm256_setzero_pd();
+  __m256d p0, p1;
+  unsigned int k = 0;
+  for(; k+8<=aN; k+=8){
+    p0 = _mm256_mul_pd(_mm256_loadu_pd(aA+k), _mm256_loadu_pd(aB+k));     O_SIMD_NOFMA(p0);
+    p1 = _mm256_mul_pd(_mm256_loadu_pd(aA+k+4), _mm256_loadu_pd(aB+k+4)); O_SIMD_NOFMA(p1);
+    s0 = _mm256_add_pd(s0, p0);
+    s1 = _mm256_add_pd(s1, p1);
+  }
+  double s[8];
+  _mm256_storeu_pd(s, s0);
+  _mm256_storeu_pd(s+4, s1);
+  double sum = OsimdSum8(s);
+  double p;
+  for(; k<aN; k++){
+    p = aA[k]*aB[k]; O_SIMD_NOFMA(p);
+    sum += p;
+  }
+  return sum;
+}
+
+__attribute__((target("avx512f")))
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindowAvx512(const unsigned int aN, const double *aIn,
+                       const double *aWindowRe, const double *aWindowIm, double *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int k = 0;
+  const __m512i idx_re = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+  const __m512i idx_im = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+  const __m512i idx_lo = _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0);
+  const __m512i idx_hi = _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4);
+  __m512d x0, x1, re, im, wr, wi, rr, ii, ri, ir, yre, yim;
+  for(; k+8<=aN; k+=8){
+    x0  = _mm512_loadu_pd(aIn+2*k);
+    x1  = _mm512_loadu_pd(aIn+2*k+8);
+    re  = _mm512_permutex2var_pd(x0, idx_re, x1);
+    im  = _mm512_permutex2var_pd(x0, idx_im, x1);
+    wr  = _mm512_loadu_pd(aWindowRe+k);
+    wi  = _mm512_loadu_pd(aWindowIm+k);
+    rr  = _mm512_mul_pd(re, wr); O_SIMD_NOFMA(rr);
+    ii  = _mm512_mul_pd(im, wi); O_SIMD_NOFMA(ii);
+    ri  = _mm512_mul_pd(re, wi); O_SIMD_NOFMA(ri);
+    ir  = _mm512_mul_pd(im, wr); O_SIMD_NOFMA(ir);
+    yre = _mm512_sub_pd(rr, ii);
+    yim = _mm512_add_pd(ri, ir);
+    _mm512_storeu_pd(aOut+2*k,   _mm512_permutex2var_pd(yre, idx_lo, yim));
+    _mm512_storeu_pd(aOut+2*k+8, _mm512_permutex2var_pd(yre, idx_hi, yim));
+  }
+  OsimdWindowScalar(aN-k, aIn+2*k, aWindowRe+k, aWindowIm+k, aOut+2*k);
+}
+
+__attribute__((target("avx512f")))
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSqAvx512(const unsigned int aN, const double *aZ,
+                        const double aSnrSqThr, long unsigned int &aAboveN,
+                        unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int k = 0;
+  const __m512i idx_re = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+  const __m512i idx_im = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d two = _mm512_set1_pd(2.0);
+  const __m512d thr = _mm512_set1_pd(aSnrSqThr);
+  __m512d vmax = zero;
+  __m512d z0, z1, re, im, rr, ii, snrsq;
+  long unsigned int n = 0;
+  __mmask8 mask;
+  for(; k+8<=aN; k+=8){
+    z0    = _mm512_loadu_pd(aZ+2*k);
+    z1    = _mm512_loadu_pd(aZ+2*k+8);
+    re    = _mm512_permutex2var_pd(z0, idx_re, z1);
+    im    = _mm512_permutex2var_pd(z0, idx_im, z1);
+    rr    = _mm512_mul_pd(re, re); O_SIMD_NOFMA(rr);
+    ii    = _mm512_mul_pd(im, im); O_SIMD_NOFMA(ii);
+    snrsq = _mm512_sub_pd(_mm512_add_pd(rr, ii), two);
+    snrsq = _mm512_mask_max_pd(zero, 0xFF, zero, snrsq);// NaN is kept
+    vmax  = _mm512_mask_max_pd(vmax, 0xFF, snrsq, vmax);// NaN is ignored
+    mask  = _mm512_cmp_pd_mask(snrsq, thr, _CMP_GE_OQ);
+    if(mask==0) continue;
+    if(aAboveIndex==NULL) n += __builtin_popcount(mask);
+    else for(unsigned int j=0; j<8; j++) if(mask&(1<<j)) aAboveIndex[n++] = k+j;
+  }
+  double m[8];
+  _mm512_storeu_pd(m, vmax);
+  long unsigned int ntail;
+  double snrsqmax = OsimdSnrSqScalar(aN-k, aZ+2*k, aSnrSqThr, ntail, aAboveIndex==NULL ? NULL : aAboveIndex+n);
+  if(aAboveIndex!=NULL) for(unsigned int j=0; j<ntail; j++) aAboveIndex[n+j] += k;
+  for(unsigned int j=0; j<8; j++) if(m[j]>snrsqmax) snrsqmax = m[j];
+  aAboveN = n+ntail;
+  return snrsqmax;
+}
+
+__attribute__((target("avx512f")))
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdDotAvx512(const unsigned int aN, const double *aA, const double *aB){
+////////////////////////////////////////////////////////////////////////////////////
+  __m512d s0 = _mm512_setzero_pd();
+  __m512d p0;
+  unsigned int k = 0;
+  for(; k+8<=aN; k+=8){
+    p0 = _mm512_mul_pd(_mm512_loadu_pd(aA+k), _mm512_loadu_pd(aB+k)); O_SIMD_NOFMA(p0);
+    s0 = _mm512_add_pd(s0, p0);
+  }
+  double s[8];
+  _mm512_storeu_pd(s, s0);
+  double sum = OsimdSum8(s);
+  double p;
+  for(; k<aN; k++){
+    p = aA[k]*aB[k]; O_SIMD_NOFMA(p);
+    sum += p;
+  }
+  return sum;
+}
+
+__attribute__((target("avx2")))
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindowAvx2F(const unsigned int aN, const double *aIn,
+                      const float *aWindowRe, const float *aWindowIm, float *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+  unsigned int k = 0;
+  const __m256i idx_de = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  __m256 x01, x23, re, im, wr, wi, rr, ii, ri, ir, yre, yim;
+  for(; k+8<=aN; k+=8){
+    // r0 i0 r1 i1 r2 i2 r3 i3 / r4 i4 ... (converted to float)
+    x01 = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_loadu_pd(aIn+2*k+4)), _mm256_cvtpd_ps(_mm256_loadu_pd(aIn+2*k)));
+    x23 = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_loadu_pd(aIn+2*k+12)), _mm256_cvtpd_ps(_mm256_loadu_pd(aIn+2*k+8)));
+    x01 = _mm256_permutevar8x32_ps(x01, idx_de);      // r0 r1 r2 r3 i0 i1 i2 i3
+    x23 = _mm256_permutevar8x32_ps(x23, idx_de);      // r4 r5 r6 r7 i4 i5 i6 i7
+    re  = _mm256_permute2f128_ps(x01, x23, 0x20);
+    im  = _mm256_permute2f128_ps(x01, x23, 0x31);
+    wr  = _mm256_loadu_ps(aWindowRe+k);
+    wi  = _mm256_loadu_ps(aWindowIm+k);
+    rr  = _mm256_mul_ps(re, wr); O_SIMD_NOFMA(rr);
+    ii  = _mm256_mul_ps(im, wi); O_SIMD_NOFMA(ii);
+    ri  = _mm256_mul_ps(re, wi); O_SIMD_NOFMA(ri);
+    ir  = _mm256_mul_ps(im, wr); O_SIMD_NOFMA(ir);
+    yre = _mm256_sub_ps(rr, ii);
+    yim = _mm256_add_ps(ri, ir);
+    x01 = _mm256_unpacklo_ps(yre, yim);               // yr0 yi0 yr1 yi1 yr4 yi4 yr5 yi5
+    x23 = _mm256_unpackhi_ps(yre, yim);               // yr2 yi2 yr3 yi3 yr6 yi6 yr7 yi7
+    _mm256_storeu_ps(aOut+2*k,   _mm256_permute2f128_ps(x01, x23, 0x20));
+    _mm256_storeu_ps(aOut+2*k+8, _mm256_permute2f128_ps(x01, x23, 0x31));
+  }
+  OsimdWindowScalarF(aN-k, aIn+2*k, aWindowRe+k, aWindowIm+k, aOut+2*k);
+}
+
+__attribute__((target("avx2")))
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSqAvx2F(const unsigned int aN, const float *aZ,
+                       const float aSnrSqThr, long unsigned int &aAboveN,
+                       unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+  const unsigned int lane[8] = {0, 1, 4, 5, 2, 3, 6, 7};// tile -> mask bit
+  unsigned int k = 0;
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 two = _mm256_set1_ps(2.0f);
+  const __m256 thr = _mm256_set1_ps(aSnrSqThr);
+  __m256 vmax = zero;
+  __m256 z0, z1, sq0, sq1, snrsq;
+  long unsigned int n = 0;
+  int mask;
+  for(; k+8<=aN; k+=8){
+    z0    = _mm256_loadu_ps(aZ+2*k);
+    z1    = _mm256_loadu_ps(aZ+2*k+8);
+    sq0   = _mm256_mul_ps(z0, z0);
+    sq1   = _mm256_mul_ps(z1, z1);
+    O_SIMD_NOFMA(sq0);
+    O_SIMD_NOFMA(sq1);
+    snrsq = _mm256_sub_ps(_mm256_hadd_ps(sq0, sq1), two);// 0 1 4 5 2 3 6 7
+    snrsq = _mm256_max_ps(zero, snrsq);               // NaN is kept
+    vmax  = _mm256_max_ps(snrsq, vmax);               // NaN is ignored
+    mask  = _mm256_movemask_ps(_mm256_cmp_ps(snrsq, thr, _CMP_GE_OQ));
+    if(mask==0) continue;
+    if(aAboveIndex==NULL) n += __builtin_popcount(mask);
+    else for(unsigned int j=0; j<8; j++) if(mask&(1<<lane[j])) aAboveIndex[n++] = k+j;
+  }
+  float m[8];
+  _mm256_storeu_ps(m, vmax);
+  long unsigned int ntail;
+  double snrsqmax = OsimdSnrSqScalarF(aN-k, aZ+2*k, aSnrSqThr, ntail, aAboveIndex==NULL ? NULL : aAboveIndex+n);
+  if(aAboveIndex!=NULL) for(unsigned int j=0; j<ntail; j++) aAboveIndex[n+j] += k;
+  for(unsigned int j=0; j<8; j++) if((double)m[j]>snrsqmax) snrsqmax = (double)m[j];
+  aAboveN = n+ntail;
+  return snrsqmax;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////
+OsimdType OsimdGetType(void){
+////////////////////////////////////////////////////////////////////////////////////
+  static OsimdType type = [](){
+    OsimdType t = osimd_scalar;
+#ifdef O_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) t = osimd_avx2;
+    if(__builtin_cpu_supports("avx512f")) t = osimd_avx512;
+#endif
+    char *env = getenv("OMICRON_SIMD");
+    if(env!=NULL){
+      if(!strcmp(env, "scalar")) t = osimd_scalar;
+      else if(!strcmp(env, "avx2")&&(t>osimd_avx2)) t = osimd_avx2;
+    }
+    return t;
+  }();
+  return type;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindow(const unsigned int aN, const double *aIn,
+                 const double *aWindowRe, const double *aWindowIm, double *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+#ifdef O_SIMD_X86
+  switch(OsimdGetType()){
+  case osimd_avx512: OsimdWindowAvx512(aN, aIn, aWindowRe, aWindowIm, aOut); return;
+  case osimd_avx2:   OsimdWindowAvx2(aN, aIn, aWindowRe, aWindowIm, aOut);   return;
+  default: break;
+  }
+#endif
+  OsimdWindowScalar(aN, aIn, aWindowRe, aWindowIm, aOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSq(const unsigned int aN, const double *aZ,
+                  const double aSnrSqThr, long unsigned int &aAboveN,
+                  unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+#ifdef O_SIMD_X86
+  switch(OsimdGetType()){
+  case osimd_avx512: return OsimdSnrSqAvx512(aN, aZ, aSnrSqThr, aAboveN, aAboveIndex);
+  case osimd_avx2:   return OsimdSnrSqAvx2(aN, aZ, aSnrSqThr, aAboveN, aAboveIndex);
+  default: break;
+  }
+#endif
+  return OsimdSnrSqScalar(aN, aZ, aSnrSqThr, aAboveN, aAboveIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+void OsimdWindow(const unsigned int aN, const double *aIn,
+                 const float *aWindowRe, const float *aWindowIm, float *aOut){
+////////////////////////////////////////////////////////////////////////////////////
+#ifdef O_SIMD_X86
+  if(OsimdGetType()>=osimd_avx2){
+    OsimdWindowAvx2F(aN, aIn, aWindowRe, aWindowIm, aOut);
+    return;
+  }
+#endif
+  OsimdWindowScalarF(aN, aIn, aWindowRe, aWindowIm, aOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdSnrSq(const unsigned int aN, const float *aZ,
+                  const float aSnrSqThr, long unsigned int &aAboveN,
+                  unsigned int *aAboveIndex){
+////////////////////////////////////////////////////////////////////////////////////
+#ifdef O_SIMD_X86
+  if(OsimdGetType()>=osimd_avx2) return OsimdSnrSqAvx2F(aN, aZ, aSnrSqThr, aAboveN, aAboveIndex);
+#endif
+  return OsimdSnrSqScalarF(aN, aZ, aSnrSqThr, aAboveN, aAboveIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+double OsimdDot(const unsigned int aN, const double *aA, const double *aB){
+////////////////////////////////////////////////////////////////////////////////////
+#ifdef O_SIMD_X86
+  switch(OsimdGetType()){
+  case osimd_avx512: return OsimdDotAvx512(aN, aA, aB);
+  case osimd_avx2:   return OsimdDotAvx2(aN, aA, aB);
+  default: break;
+  }
+#endif
+  return OsimdDotScalar(aN, aA, aB);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file 
+ * @brief See Otilecache.h
+ */
+#include "Otilecache.h"
+#include <fftw3.h>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+////////////////////////////////////////////////////////////////////////////////////
+Otilecache::Otilecache(const string aFilePath, const string aKey){
+////////////////////////////////////////////////////////////////////////////////////
+  map = NULL;
+  map_size = 0;
+  header = NULL;
+  arrays = NULL;
+  data = NULL;
+  wisdom = NULL;
+  strings = NULL;
+
+  int fd = open(aFilePath.c_str(), O_RDONLY);
+  if(fd<0) return;
+  struct stat st;
+  if((fstat(fd, &st)==0)&&((long unsigned int)st.st_size>=sizeof(Header))){
+    map_size = st.st_size;
+    map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map==MAP_FAILED) map = NULL;
+  }
+  close(fd);
+  if(map==NULL) return;
+
+  // check header and section sizes (each size is bounded by the file size before any sum)
+  const Header *h = (const Header*)map;
+  long unsigned int rem = map_size-sizeof(Header);
+  bool ok = !memcmp(h->magic, "OTCACHE", 8)&&(h->version==1);
+  ok = ok&&(h->array_n<=rem/sizeof(Array));
+  if(ok) rem -= h->array_n*sizeof(Array);
+  ok = ok&&(h->data_n<=rem/sizeof(double));
+  if(ok) rem -= h->data_n*sizeof(double);
+  ok = ok&&(h->key_size<=rem);
+  if(ok) rem -= h->key_size;
+  ok = ok&&(h->wisdom_size<=rem);
+  if(ok) rem -= h->wisdom_size;
+  ok = ok&&(h->string_size==rem);
+
+  const Array *a = (const Array*)(h+1);
+  const double *d = (const double*)(a+(ok ? h->array_n : 0));
+  const char *k = (const char*)(d+(ok ? h->data_n : 0));
+  const char *w = k+(ok ? h->key_size : 0);
+  const char *s = w+(ok ? h->wisdom_size : 0);
+
+  // key
+  ok = ok&&(h->key_size==aKey.size()+1)&&!memcmp(k, aKey.c_str(), aKey.size()+1);
+
+  // null-terminated wisdom and string table
+  ok = ok&&(h->wisdom_size>0)&&(w[h->wisdom_size-1]=='\0');
+  ok = ok&&((h->array_n==0)||((h->string_size>0)&&(s[h->string_size-1]=='\0')));
+
+  // array records
+  for(unsigned int i=0; ok&&(i<h->array_n); i++){
+    ok = (a[i].name<h->string_size)&&(a[i].offset<=h->data_n)&&(a[i].size<=h->data_n-a[i].offset);
+  }
+
+  if(!ok){
+    munmap(map, map_size);
+    map = NULL;
+    return;
+  }
+  header = h;
+  arrays = a;
+  data = d;
+  wisdom = w;
+  strings = s;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+Otilecache::~Otilecache(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(map!=NULL) munmap(map, map_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+string Otilecache::MakeKey(const unsigned int aTimeRange, const unsigned int aTimeOverlap,
+                           const double aQmin, const double aQmax,
+                           const double aFrequencyMin, const double aFrequencyMax,
+                           const unsigned int aSamplingFrequency, const double aMismatchMax){
+////////////////////////////////////////////////////////////////////////////////////
+  char key[512];
+  snprintf(key, sizeof(key),
+           "TIMING %u %u QRANGE %.17g %.17g FREQUENCYRANGE %.17g %.17g SAMPLEFREQUENCY %u MISMATCHMAX %.17g",
+           aTimeRange, aTimeOverlap, aQmin, aQmax, aFrequencyMin, aFrequencyMax, aSamplingFrequency, aMismatchMax);
+  return (string)key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+string Otilecache::MakeFilePath(const string aDirectory, const string aKey){
+////////////////////////////////////////////////////////////////////////////////////
+  char hash[32];
+  snprintf(hash, sizeof(hash), "%016lx", (long unsigned int)std::hash<string>()(aKey));
+  return aDirectory+"/omicron-tiling-"+(string)hash+".otc";
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Otilecache::Write(const string aFilePath, const string aKey,
+                       const vector<string> &aNames, const vector< vector<double> > &aArrays){
+////////////////////////////////////////////////////////////////////////////////////
+  if(aNames.size()!=aArrays.size()) return false;
+
+  // array records and string table
+  vector<Array> a(aNames.size());
+  string strtab;
+  long unsigned int data_n = 0;
+  for(unsigned int i=0; i<aNames.size(); i++){
+    a[i].name = strtab.size();
+    a[i].offset = data_n;
+    a[i].size = aArrays[i].size();
+    strtab += aNames[i];
+    strtab.push_back('\0');
+    data_n += aArrays[i].size();
+  }
+
+  // fftw wisdom
+  char *w = fftw_export_wisdom_to_string();
+  if(w==NULL) return false;
+  string wis = w;
+  free(w);
+
+  // header
+  Header h;
+  memcpy(h.magic, "OTCACHE", 8);
+  h.version = 1;
+  h.array_n = a.size();
+  h.data_n = data_n;
+  h.key_size = aKey.size()+1;
+  h.wisdom_size = wis.size()+1;
+  h.string_size = strtab.size();
+
+  // write
+  string tmp = aFilePath+".tmp."+to_string(getpid());
+  FILE *out = fopen(tmp.c_str(), "wb");
+  if(out==NULL) return false;
+  bool ok = (fwrite(&h, sizeof(Header), 1, out)==1);
+  if(a.size()) ok = ok&&(fwrite(a.data(), sizeof(Array), a.size(), out)==a.size());
+  for(unsigned int i=0; i<aArrays.size(); i++)
+    if(aArrays[i].size()) ok = ok&&(fwrite(aArrays[i].data(), sizeof(double), aArrays[i].size(), out)==aArrays[i].size());
+  ok = ok&&(fwrite(aKey.c_str(), 1, h.key_size, out)==h.key_size);
+  ok = ok&&(fwrite(wis.c_str(), 1, h.wisdom_size, out)==h.wisdom_size);
+  if(strtab.size()) ok = ok&&(fwrite(strtab.data(), 1, strtab.size(), out)==strtab.size());
+  ok = (fclose(out)==0)&&ok;
+  if(!ok||rename(tmp.c_str(), aFilePath.c_str())){
+    remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+bool Otilecache::ImportWisdom(void){
+////////////////////////////////////////////////////////////////////////////////////
+  if(header==NULL) return false;
+  return fftw_import_wisdom_from_string(wisdom)!=0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+int Otilecache::FindArray(const string aName){
+////////////////////////////////////////////////////////////////////////////////////
+  for(unsigned int i=0; i<GetArrayN(); i++)
+    if(!strcmp(strings+arrays[i].name, aName.c_str())) return (int)i;
+  return -1;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @brief Test of the Obatch class.
+ */
+#include "Obatch.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+
+/**
+ * @brief Checks a batch against a direct inverse Fourier transform of each row.
+ * @returns false if a row differs.
+ * @param[in] aSize Row size.
+ * @param[in] aRowN Number of rows.
+ * @param[in] aGen Random generator.
+ */
+static bool Check(const unsigned int aSize, const unsigned int aRowN, mt19937 &aGen){
+  uniform_real_distribution<double> u(-1.0, 1.0);
+  Obatch batch(aSize, aRowN);
+  if(!batch.GetStatus()||(batch.GetSize()!=aSize)||(batch.GetRowN()!=aRowN)){
+    cerr<<"Obatch-test: cannot create a batch "<<aSize<<"x"<<aRowN<<endl;
+    return false;
+  }
+
+  // rows of different lengths and offsets (the first row is filled twice)
+  vector< vector<double> > ref(aRowN, vector<double>(2*aSize, 0.0));
+  for(unsigned int r=0; r<aRowN; r++){
+    for(unsigned int pass=0; pass<(r==0 ? 2U : 1U); pass++){
+      unsigned int n = 1+(r+pass)*aSize/aRowN;
+      if(n>aSize) n = aSize;
+      unsigned int o = (7*r+3*pass)%aSize;
+      vector<double> x(2*n), wr(n), wi(n);
+      for(unsigned int k=0; k<2*n; k++) x[k] = u(aGen);
+      for(unsigned int k=0; k<n; k++){ wr[k] = u(aGen); wi[k] = u(aGen); }
+      batch.SetRow(r, n, x.data(), wr.data(), wi.data(), o);
+      ref[r].assign(2*aSize, 0.0);
+      for(unsigned int k=0; k<n; k++){
+        ref[r][2*((o+k)%aSize)]   = x[2*k]*wr[k]-x[2*k+1]*wi[k];
+        ref[r][2*((o+k)%aSize)+1] = x[2*k]*wi[k]+x[2*k+1]*wr[k];
+      }
+    }
+  }
+  batch.Execute();
+
+  // direct inverse DFT
+  for(unsigned int r=0; r<aRowN; r++){
+    for(unsigned int t=0; t<aSize; t++){
+      long double re = 0.0, im = 0.0;
+      for(unsigned int k=0; k<aSize; k++){
+        long double a = 2.0L*M_PI*(long double)(((long unsigned int)k*t)%aSize)/(long double)aSize;
+        re += ref[r][2*k]*cosl(a)-ref[r][2*k+1]*sinl(a);
+        im += ref[r][2*k]*sinl(a)+ref[r][2*k+1]*cosl(a);
+      }
+      fftw_complex *row = batch.GetRow(r);
+      if((fabs(row[t][0]-(double)re)>1e-9*aSize)||(fabs(row[t][1]-(double)im)>1e-9*aSize)||
+         (fabs(batch.GetNorm2(r, t)-(double)(re*re+im*im))>1e-8*aSize*aSize)){
+        cerr<<"Obatch-test: "<<aSize<<"x"<<aRowN<<": row "<<r<<", sample "<<t<<" = ("<<row[t][0]<<", "<<row[t][1]<<") instead of ("<<(double)re<<", "<<(double)im<<")"<<endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 gen(12345);
+  const unsigned int sizes[][2] = {{1, 1}, {8, 3}, {64, 5}, {100, 4}, {256, 7}};
+  for(unsigned int i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+    if(!Check(sizes[i][0], sizes[i][1], gen)) return 1;
+
+  cout<<"Obatch-test: OK"<<endl;
+  return 0;
+}
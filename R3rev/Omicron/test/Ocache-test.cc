@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @brief Test of the Ocache class.
+ * @details The test frame files are in the parent directory of the Omicron installation (see Ogwf-test.cc).
+ */
+#include "Ocache.h"
+#include <atomic>
+#include <iostream>
+#include <cstring>
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  Ogwf v9("../../r.gwf");
+  Ogwf v8("../../H1_PEM-VAULT_MAG_1030X195Y_COIL_X_DQ_1238166018_1238170549.gwf");
+  if(!v9.GetStatus()||!v8.GetStatus()) return 1;
+  const string c9 = "H1:SUS-ETMX_L1_CAL_LINE_OUT_DQ";
+  const string c8 = "H1:PEM-VAULT_MAG_1030X195Y_COIL_X_DQ";
+  const long unsigned int size9 = v9.GetVectorSampleN(0)*sizeof(float);
+  const long unsigned int size8 = v8.GetVectorSampleN(0)*sizeof(float);
+
+  // reference data (direct decode)
+  const unsigned int n9 = 8*512, n8 = 64*4096;
+  const double t9 = 1238245131.0+100.0, t8 = 1238170000.0;
+  vector<float> ref9(n9), ref8(n8);
+  if((v9.Read(c9, t9, n9, ref9.data(), ogwf_type_real4, 512.0)!=n9)||
+     (v8.Read(c8, t8, n8, ref8.data(), ogwf_type_real4, 4096.0)!=n8)){
+    cerr<<"Ocache-test: cannot read the reference data"<<endl;
+    return 1;
+  }
+
+  // parallel decode: the budget fits both blocks
+  {
+    Ocache cache(4, size9+size8);
+    vector<Ogwf*> files = {&v9, &v8};
+    if((cache.Decode(files, {c9, c8}, 1238100000.0, 1238300000.0)!=2)||(cache.GetMemoryUsed()!=size9+size8)){
+      cerr<<"Ocache-test: "<<cache.GetMemoryUsed()<<" bytes cached instead of "<<size9+size8<<endl;
+      return 1;
+    }
+    if(cache.Decode(files, {c9, c8}, 1238100000.0, 1238300000.0)!=0){
+      cerr<<"Ocache-test: cached blocks decoded again"<<endl;
+      return 1;
+    }
+
+    // concurrent reads = direct decode
+    atomic<unsigned int> nbad(0);
+    vector<thread> readers;
+    for(unsigned int r=0; r<8; r++){
+      readers.push_back(thread([&, r]{
+            vector<float> b9(n9), b8(n8);
+            for(unsigned int i=0; i<10; i++){
+              if((cache.Read(&v9, c9, t9, n9, b9.data(), ogwf_type_real4, 512.0)!=n9)||
+                 memcmp(b9.data(), ref9.data(), n9*sizeof(float))) nbad++;
+              if((r%2==0)&&((cache.Read(&v8, c8, t8, n8, b8.data(), ogwf_type_real4, 4096.0)!=n8)||
+                            memcmp(b8.data(), ref8.data(), n8*sizeof(float)))) nbad++;
+            }
+          }));
+    }
+    for(unsigned int r=0; r<readers.size(); r++) readers[r].join();
+    if(nbad||(cache.GetMissN()!=0)||(cache.GetHitN()!=8*10+4*10)){
+      cerr<<"Ocache-test: concurrent reads: "<<nbad<<" errors, "<<cache.GetHitN()<<" hits, "<<cache.GetMissN()<<" misses"<<endl;
+      return 1;
+    }
+    cache.Clear();
+    if(cache.GetMemoryUsed()!=0) return 1;
+  }
+
+  // reads waiting for a background decode
+  {
+    Ocache cache(2, size9+size8);
+    thread decoder([&]{ cache.Decode({&v8, &v9}, {c8, c9}, 1238100000.0, 1238300000.0); });
+    vector<float> b8(n8);
+    unsigned int n = cache.Read(&v8, c8, t8, n8, b8.data(), ogwf_type_real4, 4096.0);
+    decoder.join();
+    if((n!=n8)||memcmp(b8.data(), ref8.data(), n8*sizeof(float))||(cache.GetMemoryUsed()!=size9+size8)){
+      cerr<<"Ocache-test: wrong read during a background decode"<<endl;
+      return 1;
+    }
+  }
+
+  // LRU: the budget fits one block only
+  {
+    Ocache cache(1, size8);
+    vector<float> b9(n9), b8(n8);
+    cache.Read(&v9, c9, t9, n9, b9.data(), ogwf_type_real4, 512.0);
+    if(cache.GetMemoryUsed()!=size9) return 1;
+    cache.Read(&v8, c8, t8, n8, b8.data(), ogwf_type_real4, 4096.0);
+    if((cache.GetMemoryUsed()!=size8)||(cache.GetMissN()!=2)){
+      cerr<<"Ocache-test: the least recently used block is not removed"<<endl;
+      return 1;
+    }
+    cache.Read(&v8, c8, t8, n8, b8.data(), ogwf_type_real4, 4096.0);
+    if((cache.GetHitN()!=1)||memcmp(b8.data(), ref8.data(), n8*sizeof(float))) return 1;
+  }
+
+  // blocks larger than the budget are never cached, but they are read
+  {
+    Ocache cache(2, size9);
+    vector<float> b8(n8);
+    if((cache.Decode({&v8}, {c8}, t8, t8+1.0)!=0)||
+       (cache.Read(&v8, c8, t8, n8, b8.data(), ogwf_type_real4, 4096.0)!=n8)||
+       memcmp(b8.data(), ref8.data(), n8*sizeof(float))||(cache.GetMemoryUsed()!=0)){
+      cerr<<"Ocache-test: wrong handling of a block larger than the budget"<<endl;
+      return 1;
+    }
+    if(cache.Read(&v8, c8, t8, n8, b8.data(), ogwf_type_real8, 4096.0)!=0){
+      cerr<<"Ocache-test: type mismatch accepted"<<endl;
+      return 1;
+    }
+  }
+
+  cout<<"Ocache-test: OK"<<endl;
+  return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file
+ * @brief Test of the Ocondition class.
+ */
+#include "Ocondition.h"
+#include <complex>
+#include <random>
+
+/**
+ * @brief Reference high-pass filter.
+ * @details Butterworth high-pass filter designed from its poles and applied in direct form I, independently of Ocondition.
+ * The analog prototype poles are mapped with the bilinear transform; each pair of poles gives a section with a double zero at \f$z=1\f$ and a unit gain at the Nyquist frequency.
+ * @param[in] aX Input data (modified in place).
+ * @param[in] aFrequency Cutoff frequency [Hz].
+ * @param[in] aSamplingFrequency Sampling frequency [Hz].
+ * @param[in] aOrder Filter order.
+ */
+static void HighPass(vector<double> &aX, const double aFrequency, const double aSamplingFrequency, const unsigned int aOrder){
+  const double k = tan(M_PI*aFrequency/aSamplingFrequency);
+  for(unsigned int s=0; s<aOrder/2; s++){
+    complex<double> pa = exp(complex<double>(0.0, M_PI*(2.0*s+1.0+aOrder)/(2.0*aOrder)));// low-pass prototype
+    complex<double> ph = k/pa;                                                     // high-pass
+    complex<double> pz = (1.0+ph)/(1.0-ph);                                        // bilinear
+    double a1 = -2.0*pz.real(), a2 = norm(pz);
+    double g = (1.0-a1+a2)/4.0;
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0, y;
+    for(unsigned int i=0; i<aX.size(); i++){
+      y = g*(aX[i]-2.0*x1+x2)-a1*y1-a2*y2;
+      x2 = x1; x1 = aX[i];
+      y2 = y1; y1 = y;
+      aX[i] = y;
+    }
+  }
+}
+
+/**
+ * @brief Returns the RMS of a vector, ignoring the edges.
+ * @param[in] aX Vector.
+ * @param[in] aEdge Number of samples to ignore at each edge.
+ */
+static double Rms(const vector<double> &aX, const unsigned int aEdge){
+  double s = 0.0;
+  for(unsigned int i=aEdge; i<aX.size()-aEdge; i++) s += aX[i]*aX[i];
+  return sqrt(s/(double)(aX.size()-2*aEdge));
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 rng(4321);
+  normal_distribution<double> gauss(0.0, 1.0);
+
+  // the size is not a multiple of the block size
+  const unsigned int native = 4096, working = 1024, ratio = native/working;
+  const unsigned int nout = 5*working+3, nin = nout*ratio;
+  vector<double> in(nin), out(nout), ref;
+
+  // invalid configurations
+  Ocondition bad(4096, 1000, 0.0);
+  if(bad.IsValid()||bad.Process(nin, in.data(), nout, out.data())){
+    cerr<<"Ocondition-test: non-integer decimation factor accepted"<<endl;
+    return 1;
+  }
+  Ocondition cond(native, working, 16.0);
+  if(!cond.IsValid()||cond.Process(nin, in.data(), nout+1, out.data())){
+    cerr<<"Ocondition-test: inconsistent vector sizes accepted"<<endl;
+    return 1;
+  }
+
+  // no decimation: high-pass filter versus the reference
+  for(unsigned int i=0; i<nin; i++) in[i] = 3.0+gauss(rng);
+  Ocondition hp(native, native, 30.0, 8);
+  vector<double> full(nin);
+  hp.Process(nin, in.data(), nin, full.data());
+  ref = in;
+  double mean = 0.0;
+  for(unsigned int i=0; i<nin; i++) mean += ref[i];
+  mean /= (double)nin;
+  for(unsigned int i=0; i<nin; i++) ref[i] -= mean;
+  HighPass(ref, 30.0, (double)native, 8);
+  for(unsigned int i=0; i<nin; i++){
+    if(fabs(full[i]-ref[i])>1e-9){
+      cerr<<"Ocondition-test: high-pass filter: sample "<<i<<" = "<<full[i]<<" instead of "<<ref[i]<<endl;
+      return 1;
+    }
+  }
+
+  // odd order: rounded up to the next even order
+  Ocondition hp7(native, native, 30.0, 7);
+  vector<double> full7(nin);
+  hp7.Process(nin, in.data(), nin, full7.data());
+  if((hp7.GetOrder()!=8)||(hp.GetOrder()!=8)||memcmp(full.data(), full7.data(), nin*sizeof(double))){
+    cerr<<"Ocondition-test: odd order 7 not rounded up to 8 (order "<<hp7.GetOrder()<<")"<<endl;
+    return 1;
+  }
+  Ocondition hp0(native, native, 30.0, 0);
+  if(hp0.GetOrder()!=2){
+    cerr<<"Ocondition-test: order 0 gives order "<<hp0.GetOrder()<<" instead of 2"<<endl;
+    return 1;
+  }
+
+  // DC component
+  for(unsigned int i=0; i<nin; i++) in[i] = 5.0;
+  cond.Process(nin, in.data(), nout, out.data());
+  for(unsigned int i=0; i<nout; i++){
+    if(fabs(out[i])>1e-12){
+      cerr<<"Ocondition-test: DC component not removed"<<endl;
+      return 1;
+    }
+  }
+
+  // pass band (100 Hz) and stop band (1500 Hz, above the working Nyquist frequency)
+  const double freq[2] = {100.0, 1500.0};
+  for(unsigned int f=0; f<2; f++){
+    for(unsigned int i=0; i<nin; i++) in[i] = sin(2.0*M_PI*freq[f]*(double)i/(double)native);
+    cond.Process(nin, in.data(), nout, out.data());
+    double rms = Rms(out, working/4);
+    if((f==0)&&(fabs(rms*sqrt(2.0)-1.0)>1e-2)){
+      cerr<<"Ocondition-test: pass-band gain = "<<rms*sqrt(2.0)<<endl;
+      return 1;
+    }
+    if((f==1)&&(rms*sqrt(2.0)>1e-3)){
+      cerr<<"Ocondition-test: stop-band gain = "<<rms*sqrt(2.0)<<endl;
+      return 1;
+    }
+  }
+
+  // native float input = double input
+  vector<float> inf(nin);
+  for(unsigned int i=0; i<nin; i++){
+    inf[i] = (float)(1e-3*gauss(rng));
+    in[i] = (double)inf[i];
+  }
+  vector<double> outf(nout);
+  cond.Process(nin, in.data(), nout, out.data());
+  cond.Process(nin, inf.data(), nout, outf.data());
+  if(memcmp(out.data(), outf.data(), nout*sizeof(double))){
+    cerr<<"Ocondition-test: float and double inputs give different results"<<endl;
+    return 1;
+  }
+
+  // window
+  vector<double> w(nout);
+  for(unsigned int i=0; i<nout; i++) w[i] = 0.5-0.5*cos(2.0*M_PI*(double)i/(double)nout);
+  cond.Process(nin, in.data(), nout, outf.data(), w.data());
+  for(unsigned int i=0; i<nout; i++){
+    if(outf[i]!=out[i]*w[i]){
+      cerr<<"Ocondition-test: window not applied"<<endl;
+      return 1;
+    }
+  }
+
+  cout<<"Ocondition-test: OK"<<endl;
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @brief Test of the Odecimator class.
+ */
+#include "Odecimator.h"
+#include <random>
+
+/**
+ * @brief Decimates a stream pushed in pieces of a given size.
+ * @returns The output samples.
+ * @param[in] aDecimator Decimator.
+ * @param[in] aIn Input stream.
+ * @param[in] aPieceSize Number of samples per Push() call.
+ */
+static vector<double> Decimate(Odecimator &aDecimator, const vector<double> &aIn, const unsigned int aPieceSize){
+  vector<double> out(aIn.size()/aDecimator.GetRatio()+aDecimator.GetLength()+1);
+  unsigned int o = 0, n;
+  for(unsigned int i=0; i<aIn.size(); i+=n){
+    n = min(aPieceSize, (unsigned int)aIn.size()-i);
+    o += aDecimator.Push(n, aIn.data()+i, out.data()+o);
+  }
+  o += aDecimator.Flush(out.data()+o);
+  out.resize(o);
+  return out;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 rng(99);
+  normal_distribution<double> gauss(0.0, 1.0);
+
+  const unsigned int ratio = 8, fs = 16384, nin = 3*O_COND_BLOCK_SIZE+101;
+  const unsigned int nout = (nin+ratio-1)/ratio;
+  Odecimator dec(ratio);
+  if(dec.GetRatio()!=ratio){
+    cerr<<"Odecimator-test: ratio = "<<dec.GetRatio()<<endl;
+    return 1;
+  }
+
+  // the output does not depend on how the stream is pushed
+  vector<double> in(nin);
+  for(unsigned int i=0; i<nin; i++) in[i] = gauss(rng);
+  vector<double> ref = Decimate(dec, in, nin);
+  if(ref.size()!=nout){
+    cerr<<"Odecimator-test: "<<ref.size()<<" output samples instead of "<<nout<<endl;
+    return 1;
+  }
+  const unsigned int pieces[] = {1, 3, 8, 1000, O_COND_BLOCK_SIZE, O_COND_BLOCK_SIZE+5};
+  for(unsigned int p=0; p<sizeof(pieces)/sizeof(pieces[0]); p++){
+    vector<double> out = Decimate(dec, in, pieces[p]);
+    if((out.size()!=nout)||memcmp(out.data(), ref.data(), nout*sizeof(double))){
+      cerr<<"Odecimator-test: the output depends on the push size ("<<pieces[p]<<")"<<endl;
+      return 1;
+    }
+  }
+
+  // DC gain = 1 (away from the stream edges)
+  const unsigned int edge = dec.GetLength()/ratio;
+  for(unsigned int i=0; i<nin; i++) in[i] = 1.0;
+  vector<double> out = Decimate(dec, in, 777);
+  for(unsigned int m=edge; m<nout-edge; m++){
+    if(fabs(out[m]-1.0)>1e-12){
+      cerr<<"Odecimator-test: DC gain = "<<out[m]<<endl;
+      return 1;
+    }
+  }
+
+  // K=0 is replaced by K=1
+  Odecimator dec0(ratio, 0);
+  if((dec0.GetHalfLength()!=1)||(dec0.GetLength()!=2*ratio+1)){
+    cerr<<"Odecimator-test: K=0: half length = "<<dec0.GetHalfLength()<<", length = "<<dec0.GetLength()<<endl;
+    return 1;
+  }
+  out = Decimate(dec0, in, 777);
+  for(unsigned int m=1; m<nout-1; m++){
+    if(!(fabs(out[m]-1.0)<=1e-12)){
+      cerr<<"Odecimator-test: K=0: DC gain = "<<out[m]<<endl;
+      return 1;
+    }
+  }
+
+  // pass band: no delay, no attenuation
+  const double fpass = 0.3*(double)fs/(double)ratio/2.0;
+  for(unsigned int i=0; i<nin; i++) in[i] = sin(2.0*M_PI*fpass*(double)i/(double)fs);
+  out = Decimate(dec, in, 777);
+  for(unsigned int m=edge; m<nout-edge; m++){
+    if(fabs(out[m]-in[m*ratio])>1e-3){
+      cerr<<"Odecimator-test: pass band: output "<<m<<" = "<<out[m]<<" instead of "<<in[m*ratio]<<endl;
+      return 1;
+    }
+  }
+
+  // stop band: above the output Nyquist frequency
+  const double fstop = 1.3*(double)fs/(double)ratio/2.0;
+  for(unsigned int i=0; i<nin; i++) in[i] = sin(2.0*M_PI*fstop*(double)i/(double)fs);
+  out = Decimate(dec, in, 777);
+  for(unsigned int m=edge; m<nout-edge; m++){
+    if(fabs(out[m])>1e-3){
+      cerr<<"Odecimator-test: stop band: output "<<m<<" = "<<out[m]<<endl;
+      return 1;
+    }
+  }
+
+  cout<<"Odecimator-test: OK"<<endl;
+  return 0;
+}
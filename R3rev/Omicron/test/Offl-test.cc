@@ -0,0 +1,172 @@
+/**
+ * @file
+ * @brief Test of the Offl class.
+ */
+#include "Offl.h"
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <unistd.h>
+#include <cstdint>
+
+/**
+ * @brief Builds the index of a frame file list and corrupts it.
+ * @returns false if the index cannot be built or modified.
+ * @param[in] aFflFile Path to the frame file list.
+ * @param[in] aOffset Offset of the bytes to overwrite in the index file [bytes]. A negative offset is counted from the end of the file.
+ * @param[in] aBytes New bytes.
+ * @param[in] aSize Number of bytes.
+ */
+static bool Corrupt(const string aFflFile, const long int aOffset, const void *aBytes, const unsigned int aSize){
+  if(!Offl::Build(aFflFile, {"H1:A", "H1:B"}, {16384, 512})) return false;
+  fstream f((aFflFile+".oidx").c_str(), ios::in|ios::out|ios::binary);
+  if(aOffset<0) f.seekp(aOffset, ios::end);
+  else f.seekp(aOffset, ios::beg);
+  f.write((const char*)aBytes, aSize);
+  return f.good();
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  char dir[] = "/tmp/Offl-test-XXXXXX";
+  if(mkdtemp(dir)==NULL) return 1;
+  const string ffl = string(dir)+"/test.ffl";
+  const string lcf = string(dir)+"/test.lcf";
+  int status = 1;
+
+  // frame file list: unsorted, with a duplicate, a comment, a gap and two copies of the same frame
+  {
+    ofstream out(ffl.c_str());
+    out<<"# comment"<<endl;
+    out<<"/data/H-H1-1000000128-64.gwf 1000000128 64 0 0"<<endl;
+    out<<"/data/H-H1-1000000000-64.gwf 1000000000 64 0 0"<<endl;
+    out<<"/data/H-H1-1000000064-64.gwf 1000000064 64 0 0"<<endl;
+    out<<"/data/H-H1-1000000064-64.gwf 1000000064 64 0 0"<<endl;
+    out<<"/copy/H-H1-1000000064-64.gwf 1000000064 64 0 0"<<endl;
+    out<<"/data/H-H1-1000000256-64.gwf H1 1000000256 64 0 0"<<endl;
+    out<<endl;
+  }
+  {
+    ofstream out(lcf.c_str());
+    out<<"H H1_HOFT 1000000064 64 file://localhost/data/H-H1_HOFT-1000000064-64.gwf"<<endl;
+    out<<"H H1_HOFT 1000000000 64 file:///data/H-H1_HOFT-1000000000-64.gwf"<<endl;
+  }
+
+  do{
+    // no index yet
+    Offl none(ffl);
+    if(none.IsValid()||(none.GetFrameN()!=0)||(none.FindFrame(1000000000.0)!=-1)){
+      cerr<<"Offl-test: valid index without index file"<<endl;
+      break;
+    }
+
+    // build
+    if(Offl::Build(ffl, {"H1:A", "H1:B"}, {16384})){
+      cerr<<"Offl-test: inconsistent channel table accepted"<<endl;
+      break;
+    }
+    if(!Offl::Build(ffl, {"H1:A", "H1:B"}, {16384, 512})){
+      cerr<<"Offl-test: cannot build the index"<<endl;
+      break;
+    }
+    Offl index(ffl);
+    if(!index.IsValid()||(index.GetFrameN()!=5)){
+      cerr<<"Offl-test: "<<index.GetFrameN()<<" frames instead of 5"<<endl;
+      break;
+    }
+    bool ok = true;
+    for(unsigned int f=1; f<index.GetFrameN(); f++) ok &= (index.GetFrameStart(f-1)<=index.GetFrameStart(f));
+    ok &= (index.GetFramePath(0)=="/data/H-H1-1000000000-64.gwf")&&(index.GetFrameDuration(0)==64.0);
+    ok &= (index.GetFrameStart(4)==1000000256.0);
+    ok &= (index.GetChannelN()==2)&&(index.GetChannelName(1)=="H1:B")&&(index.GetChannelSampling(1)==512);
+    if(!ok){
+      cerr<<"Offl-test: wrong index content"<<endl;
+      break;
+    }
+
+    // search
+    ok &= (index.FindFrame(1000000000.0)==0);
+    ok &= (index.FindFrame(1000000063.9)==0);
+    ok &= (index.GetFrameStart(index.FindFrame(1000000100.0))==1000000064.0);
+    ok &= (index.FindFrame(1000000200.0)==-1);// gap
+    ok &= (index.FindFrame(999999999.0)==-1);
+    ok &= (index.FindFrame(1000000320.0)==-1);
+    unsigned int first, last;
+    ok &= index.GetFrames(1000000032.0, 1000000160.0, first, last)&&(first==0)&&(last==4);
+    ok &= index.GetFrames(1000000064.0, 1000000128.0, first, last)&&(first==1)&&(last==3);
+    ok &= !index.GetFrames(1000000192.0, 1000000256.0, first, last);
+    if(!ok){
+      cerr<<"Offl-test: wrong search result"<<endl;
+      break;
+    }
+
+    // LCF, custom index path
+    const string lidx = string(dir)+"/lcf.idx";
+    Offl::Build(lcf, {}, {}, lidx);
+    Offl lindex(lcf, lidx);
+    if(!lindex.IsValid()||(lindex.GetFrameN()!=2)||(lindex.GetFramePath(1)!="/data/H-H1_HOFT-1000000064-64.gwf")){
+      cerr<<"Offl-test: wrong LCF index"<<endl;
+      break;
+    }
+
+    // stale index: the frame file list changed
+    {
+      ofstream out(ffl.c_str(), ios::app);
+      out<<"/data/H-H1-1000000320-64.gwf 1000000320 64 0 0"<<endl;
+    }
+    Offl stale(ffl);
+    if(stale.IsValid()){
+      cerr<<"Offl-test: stale index accepted"<<endl;
+      break;
+    }
+
+    // corrupted index
+    Offl::Build(ffl, {}, {});
+    if(truncate((ffl+".oidx").c_str(), 60)) break;
+    Offl corrupted(ffl);
+    if(corrupted.IsValid()){
+      cerr<<"Offl-test: corrupted index accepted"<<endl;
+      break;
+    }
+
+    // corrupted offsets and sizes (header: 48 bytes, frame: 24 bytes, channel: 16 bytes)
+    Offl::Build(ffl, {"H1:A", "H1:B"}, {16384, 512});
+    long unsigned int frame_n;
+    {
+      Offl rebuilt(ffl);
+      if(!rebuilt.IsValid()){
+        cerr<<"Offl-test: cannot rebuild the index"<<endl;
+        break;
+      }
+      frame_n = rebuilt.GetFrameN();
+    }
+    const uint64_t huge = (uint64_t)1<<40;
+    const uint64_t wrap = frame_n+((uint64_t)1<<61);// frame_n*24 is unchanged modulo 2^64
+    const char junk = 'x';
+    const struct{ long int offset; const void *bytes; unsigned int size; const char *what; } cases[] = {
+      {48+16,             &huge, 8, "frame path offset"},
+      {(long int)(48+frame_n*24), &huge, 8, "channel name offset"},
+      {-1,                &junk, 1, "string table end"},
+      {32,                &wrap, 8, "number of frames"},
+    };
+    for(unsigned int c=0; c<sizeof(cases)/sizeof(cases[0]); c++){
+      if(!Corrupt(ffl, cases[c].offset, cases[c].bytes, cases[c].size)){ ok = false; break; }
+      Offl bad(ffl);
+      if(bad.IsValid()){
+        cerr<<"Offl-test: corrupted index accepted ("<<cases[c].what<<")"<<endl;
+        ok = false;
+        break;
+      }
+    }
+    if(!ok) break;
+
+    status = 0;
+  } while(false);
+
+  system(("rm -rf "+string(dir)).c_str());
+  if(status==0) cout<<"Offl-test: OK"<<endl;
+  return status;
+}
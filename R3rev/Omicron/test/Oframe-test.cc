@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @brief Test of the Oframe class.
+ * @details The test frame files are in the parent directory of the Omicron installation (see Ogwf-test.cc).
+ */
+#include "Oframe.h"
+#include <iostream>
+#include <cstring>
+
+/**
+ * @brief Compares the data of a channel with Ogwf::Read().
+ * @returns false if the data differ.
+ * @param[in] aFrame Multi-channel reader.
+ * @param[in] aChannelIndex Channel index.
+ * @param[in] aFile Frame file containing the channel.
+ * @param[in] aGpsStart GPS start time of the chunk [s].
+ * @param[in] aLoadedN Expected number of decoded samples.
+ */
+static bool Check(Oframe &aFrame, const unsigned int aChannelIndex, const string aFile,
+                  const double aGpsStart, const long unsigned int aLoadedN){
+  Ogwf gwf(aFile);
+  OgwfType type;
+  double fs;
+  if(!gwf.GetChannel(aFrame.GetChannelName(aChannelIndex), type, fs)) return false;
+  if((aFrame.GetType(aChannelIndex)!=type)||(aFrame.GetSamplingFrequency(aChannelIndex)!=fs)||
+     (aFrame.GetLoadedN(aChannelIndex)!=aLoadedN)){
+    cerr<<"Oframe-test: "<<aFrame.GetChannelName(aChannelIndex)<<": "<<aFrame.GetLoadedN(aChannelIndex)<<" samples loaded instead of "<<aLoadedN<<endl;
+    return false;
+  }
+  const long unsigned int n = aFrame.GetSampleN(aChannelIndex);
+  vector<char> ref(n*Ogwf::GetTypeSize(type), 0);
+  gwf.Read(aFrame.GetChannelName(aChannelIndex), aGpsStart, n, ref.data(), type, fs);
+  if(memcmp(ref.data(), aFrame.GetData(aChannelIndex), ref.size())){
+    cerr<<"Oframe-test: "<<aFrame.GetChannelName(aChannelIndex)<<": the data differ from Ogwf::Read()"<<endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  const string f9 = "../../r.gwf";
+  const string f8 = "../../H1_PEM-VAULT_MAG_1030X195Y_COIL_X_DQ_1238166018_1238170549.gwf";
+  const string c9 = "H1:SUS-ETMX_L1_CAL_LINE_OUT_DQ";
+  const string c8 = "H1:PEM-VAULT_MAG_1030X195Y_COIL_X_DQ";
+  Oframe frame({c8, "H1:NONE", c9});
+  if((frame.GetChannelN()!=3)||(frame.GetChannelName(1)!="H1:NONE")) return 1;
+
+  // chunk in the second file: one channel, partially covered
+  if(frame.Load({f9, f8, "Oframe-test.cc"}, 1238170500.0, 1238170564.0)!=2){
+    cerr<<"Oframe-test: wrong number of frame files read"<<endl;
+    return 1;
+  }
+  if(!Check(frame, 0, f8, 1238170500.0, 49*4096)) return 1;
+  if((frame.GetSampleN(0)!=64*4096)||(frame.GetType(1)!=ogwf_type_unknown)||(frame.GetSampleN(1)!=0)||
+     (frame.GetLoadedN(2)!=0)){
+    cerr<<"Oframe-test: wrong data for the channels out of the chunk"<<endl;
+    return 1;
+  }
+
+  // chunk in the first file: the previous data are discarded
+  if(frame.Load({f8, f9}, 1238245131.0, 1238245131.0+64.0)!=2) return 1;
+  if(!Check(frame, 2, f9, 1238245131.0, 64*512)) return 1;
+  const float *data = (const float*)frame.GetData(0);
+  for(unsigned int i=0; i<frame.GetSampleN(0); i++){
+    if((frame.GetLoadedN(0)!=0)||(data[i]!=0.0f)){
+      cerr<<"Oframe-test: the previous chunk is not discarded"<<endl;
+      return 1;
+    }
+  }
+  const float ref[2] = {57.40827941894531f, 82.0675277709961f};
+  data = (const float*)frame.GetData(2);
+  if((data[0]!=ref[0])||(data[1]!=ref[1])){
+    cerr<<"Oframe-test: wrong samples: "<<data[0]<<" "<<data[1]<<endl;
+    return 1;
+  }
+
+  cout<<"Oframe-test: OK"<<endl;
+  return 0;
+}
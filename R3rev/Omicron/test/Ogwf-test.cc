@@ -0,0 +1,114 @@
+/**
+ * @file
+ * @brief Test of the Ogwf class.
+ * @details The test frame files are in the parent directory of the Omicron installation: a version 9 file with a gzip-compressed (0x8002) vector and a version 8 file with a gzip-compressed (0x101) vector.
+ * The reference values were decoded independently with zlib.
+ */
+#include "Ogwf.h"
+#include <iostream>
+#include <cstring>
+
+/**
+ * @brief Reads 4 samples and compares them to reference values.
+ * @returns false if the samples differ.
+ * @param[in] aGwf Frame file.
+ * @param[in] aChannel Channel name.
+ * @param[in] aGps GPS time of the first sample [s].
+ * @param[in] aRef Reference values.
+ */
+static bool Check(Ogwf &aGwf, const string aChannel, const double aGps, const float *aRef){
+  float buf[4];
+  OgwfType type;
+  double fs;
+  if(!aGwf.GetChannel(aChannel, type, fs)||(type!=ogwf_type_real4)){
+    cerr<<"Ogwf-test: "<<aChannel<<" not found in "<<aGwf.GetFilePath()<<endl;
+    return false;
+  }
+  if(aGwf.Read(aChannel, aGps, 4, buf, type, fs)!=4){
+    cerr<<"Ogwf-test: cannot read "<<aChannel<<" at "<<(long int)aGps<<endl;
+    return false;
+  }
+  for(unsigned int i=0; i<4; i++){
+    if(buf[i]!=aRef[i]){
+      cerr<<"Ogwf-test: "<<aChannel<<" at "<<(long int)aGps<<": sample "<<i<<" = "<<buf[i]<<" instead of "<<aRef[i]<<endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  // not a frame file
+  Ogwf bad("Ogwf-test.cc");
+  if(bad.GetStatus()){
+    cerr<<"Ogwf-test: a source file is read as a frame file"<<endl;
+    return 1;
+  }
+
+  // version 9, gzip (0x8002)
+  Ogwf v9("../../r.gwf");
+  const string c9 = "H1:SUS-ETMX_L1_CAL_LINE_OUT_DQ";
+  OgwfType type;
+  double fs;
+  if(!v9.GetStatus()||(v9.GetVectorN()!=1)||!v9.GetChannel(c9, type, fs)||(fs!=512.0)){
+    cerr<<"Ogwf-test: cannot index "<<v9.GetFilePath()<<endl;
+    return 1;
+  }
+  const float r9[4] = {57.40827941894531f, 82.0675277709961f, 103.91680908203125f, 122.20800018310547f};
+  if(!Check(v9, c9, 1238245131.0, r9)) return 1;
+
+  // partial decode = slice of the full vector
+  vector<float> full(v9.GetVectorSampleN(0)), part(512);
+  if(!v9.DecodeVector(0, full.data())||(full[0]!=r9[0])){
+    cerr<<"Ogwf-test: cannot decode the full vector"<<endl;
+    return 1;
+  }
+  if((v9.Read(c9, 1238245131.0+100.0/512.0, 512, part.data(), type, fs)!=512)||memcmp(part.data(), full.data()+100, 512*sizeof(float))){
+    cerr<<"Ogwf-test: the partial decode differs from the full vector"<<endl;
+    return 1;
+  }
+
+  // buffer partially covered by the file: the rest is not modified
+  vector<float> edge(1024, -1.0f);
+  if((v9.Read(c9, 1238245131.0-1.0, 1024, edge.data(), type, fs)!=512)||(edge[511]!=-1.0f)||(edge[512]!=r9[0])){
+    cerr<<"Ogwf-test: wrong partial coverage"<<endl;
+    return 1;
+  }
+
+  // mismatches
+  if(v9.Read(c9, 1238245131.0, 4, part.data(), ogwf_type_real8, fs)||
+     v9.Read(c9, 1238245131.0, 4, part.data(), type, 1024.0)||
+     v9.Read("H1:NONE", 1238245131.0, 4, part.data(), type, fs)||
+     v9.GetChannel("H1:NONE", type, fs)){
+    cerr<<"Ogwf-test: a mismatched read is accepted"<<endl;
+    return 1;
+  }
+
+  // version 8, gzip (0x101)
+  Ogwf v8("../../H1_PEM-VAULT_MAG_1030X195Y_COIL_X_DQ_1238166018_1238170549.gwf");
+  const string c8 = "H1:PEM-VAULT_MAG_1030X195Y_COIL_X_DQ";
+  if(!v8.GetStatus()||!v8.GetChannel(c8, type, fs)||(fs!=4096.0)){
+    cerr<<"Ogwf-test: cannot index "<<v8.GetFilePath()<<endl;
+    return 1;
+  }
+  const float r8a[4] = {1198.0299072265625f, 1130.5972900390625f, 1055.3448486328125f, 978.8873901367188f};
+  const float r8b[4] = {-609.3922729492188f, -609.3421020507812f, -596.2362670898438f, -573.79443359375f};
+  if(!Check(v8, c8, 1238166018.0, r8a)) return 1;
+  if(!Check(v8, c8, 1238170000.0, r8b)) return 1;
+
+  // time range beyond the end of the file
+  vector<unsigned int> vi;
+  vector<float> tail(600*4096);
+  if((v8.Read(c8, 1238170000.0, tail.size(), tail.data(), type, fs)!=549*4096)||(tail[0]!=r8b[0])||
+     (v8.GetVectors(c8, 1238170000.0, 1238170600.0, vi)!=1)||(v8.GetVectors(c8, 1238170549.0, 1238170600.0, vi)!=0)){
+    cerr<<"Ogwf-test: wrong read at the end of the file"<<endl;
+    return 1;
+  }
+
+  cout<<"Ogwf-test: OK"<<endl;
+  return 0;
+}
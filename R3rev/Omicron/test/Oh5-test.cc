@@ -0,0 +1,247 @@
+/**
+ * @file
+ * @brief Test of the Oh5 class.
+ * @details A GWOSC-like strain file is written in the working directory and removed at the end.
+ */
+#include "Oh5.h"
+#include <iostream>
+#include <cstdio>
+
+/**
+ * @brief Number of calls to TestHandler().
+ */
+static unsigned int handler_n = 0;
+
+/**
+ * @brief Caller's HDF5 error handler: counts the calls.
+ */
+static herr_t TestHandler(hid_t, void*){
+  handler_n++;
+  return 0;
+}
+
+/**
+ * @brief Writes a GWOSC-like strain file.
+ * @details The strain samples are i+0.5, starting at 1000000000 and sampled at 16 Hz.
+ * @returns false if the file cannot be written.
+ * @param[in] aFilePath File path.
+ * @param[in] aN Number of samples.
+ */
+static bool WriteFile(const string aFilePath, const unsigned int aN){
+  hid_t f = H5Fcreate(aFilePath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if(f<0) return false;
+  hid_t gs = H5Gcreate2(f, "strain", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  hid_t gm = H5Gcreate2(f, "meta", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+  // chunked and compressed strain dataset
+  vector<double> x(aN);
+  for(unsigned int i=0; i<aN; i++) x[i] = (double)i+0.5;
+  hsize_t dims[1] = {aN};
+  hsize_t chunk[1] = {64};
+  hid_t space = H5Screate_simple(1, dims, NULL);
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(dcpl, 1, chunk);
+  H5Pset_deflate(dcpl, 4);
+  hid_t d = H5Dcreate2(gs, "Strain", H5T_IEEE_F64LE, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  bool ok = (H5Dwrite(d, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.data())>=0);
+  H5Pclose(dcpl);
+  H5Sclose(space);
+
+  // attributes
+  const double xstart = 1000000000.0, xspacing = 1.0/16.0;
+  space = H5Screate(H5S_SCALAR);
+  hid_t a = H5Acreate2(d, "Xstart", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, H5P_DEFAULT);
+  ok = ok&&(H5Awrite(a, H5T_NATIVE_DOUBLE, &xstart)>=0);
+  H5Aclose(a);
+  a = H5Acreate2(d, "Xspacing", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, H5P_DEFAULT);
+  ok = ok&&(H5Awrite(a, H5T_NATIVE_DOUBLE, &xspacing)>=0);
+  H5Aclose(a);
+  H5Dclose(d);
+
+  // detector (fixed-length string)
+  hid_t t = H5Tcopy(H5T_C_S1);
+  H5Tset_size(t, 2);
+  d = H5Dcreate2(gm, "Detector", t, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  ok = ok&&(H5Dwrite(d, t, H5S_ALL, H5S_ALL, H5P_DEFAULT, "L1")>=0);
+  H5Dclose(d);
+  H5Tclose(t);
+  H5Sclose(space);
+
+  H5Gclose(gm);
+  H5Gclose(gs);
+  H5Fclose(f);
+  return ok;
+}
+
+/**
+ * @brief Writes a strain file with a given sample type.
+ * @details The file only contains the `strain/Strain` dataset (64 samples equal to 1) and its `Xstart` and `Xspacing` attributes.
+ * @returns false if the file cannot be written.
+ * @param[in] aFilePath File path.
+ * @param[in] aFileType HDF5 type of the samples in the file.
+ */
+static bool WriteTypedFile(const string aFilePath, const hid_t aFileType){
+  hid_t f = H5Fcreate(aFilePath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if(f<0) return false;
+  hid_t gs = H5Gcreate2(f, "strain", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  vector<double> x(64, 1.0);
+  hsize_t dims[1] = {64};
+  hid_t space = H5Screate_simple(1, dims, NULL);
+  hid_t d = H5Dcreate2(gs, "Strain", aFileType, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  bool ok = (d>=0)&&(H5Dwrite(d, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, x.data())>=0);
+  H5Sclose(space);
+  const double xstart = 1000000000.0, xspacing = 1.0/16.0;
+  space = H5Screate(H5S_SCALAR);
+  hid_t a = H5Acreate2(d, "Xstart", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, H5P_DEFAULT);
+  ok = ok&&(H5Awrite(a, H5T_NATIVE_DOUBLE, &xstart)>=0);
+  H5Aclose(a);
+  a = H5Acreate2(d, "Xspacing", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, H5P_DEFAULT);
+  ok = ok&&(H5Awrite(a, H5T_NATIVE_DOUBLE, &xspacing)>=0);
+  H5Aclose(a);
+  H5Sclose(space);
+  H5Dclose(d);
+  H5Gclose(gs);
+  H5Fclose(f);
+  return ok;
+}
+
+/**
+ * @brief Checks the native type detection.
+ * @details Unsigned integers and floating-point sizes other than 4 and 8 bytes must be marked as unknown.
+ * @returns false if a check fails.
+ * @param[in] aFilePath Test file path.
+ */
+static bool CheckTypes(const string aFilePath){
+  // half precision: IEEE layout on 2 bytes
+  hid_t f16 = H5Tcopy(H5T_IEEE_F32LE);
+  H5Tset_fields(f16, 15, 10, 5, 0, 10);
+  H5Tset_precision(f16, 16);
+  H5Tset_size(f16, 2);
+  H5Tset_ebias(f16, 15);
+
+  const struct{ hid_t type; OgwfType expected; const char *name; } cases[] = {
+    {H5T_STD_I16LE,      ogwf_type_int16,   "int16"},
+    {H5T_STD_I32BE,      ogwf_type_int32,   "int32 (big endian)"},
+    {H5T_IEEE_F32LE,     ogwf_type_real4,   "float32"},
+    {H5T_IEEE_F64BE,     ogwf_type_real8,   "float64 (big endian)"},
+    {H5T_STD_U16LE,      ogwf_type_unknown, "uint16"},
+    {H5T_STD_U32LE,      ogwf_type_unknown, "uint32"},
+    {H5T_STD_I64LE,      ogwf_type_unknown, "int64"},
+    {H5T_NATIVE_LDOUBLE, ogwf_type_unknown, "long double"},
+    {f16,                ogwf_type_unknown, "float16"},
+  };
+  bool ok = true;
+  for(unsigned int c=0; ok&&(c<sizeof(cases)/sizeof(cases[0])); c++){
+    if(!WriteTypedFile(aFilePath, cases[c].type)){
+      cerr<<"Oh5-test: cannot write a "<<cases[c].name<<" file"<<endl;
+      ok = false;
+      break;
+    }
+    Oh5 h5(aFilePath);
+    if((h5.GetType()!=cases[c].expected)||(h5.GetStatus()!=(cases[c].expected!=ogwf_type_unknown))){
+      cerr<<"Oh5-test: "<<cases[c].name<<" samples: type "<<(int)h5.GetType()<<" instead of "<<(int)cases[c].expected<<endl;
+      ok = false;
+    }
+  }
+  H5Tclose(f16);
+  remove(aFilePath.c_str());
+  return ok;
+}
+
+/**
+ * @brief Checks the Oh5 class with the test file.
+ * @returns false if a check fails.
+ * @param[in] aFilePath Test file path.
+ * @param[in] aN Number of samples in the test file.
+ */
+static bool Check(const string aFilePath, const unsigned int aN){
+  // errors are not printed by HDF5
+  Oh5 missing("Oh5-test-missing.h5");
+  Oh5 nodset(aFilePath, "strain/None");
+  if(missing.GetStatus()||nodset.GetStatus()||(handler_n!=0)){
+    cerr<<"Oh5-test: HDF5 errors reported to the caller's handler ("<<handler_n<<")"<<endl;
+    return false;
+  }
+
+  // attributes
+  Oh5 h5(aFilePath);
+  if(!h5.GetStatus()||(h5.GetDetector()!="L1")||(h5.GetStart()!=1000000000.0)||(h5.GetSamplingFrequency()!=16.0)||
+     (h5.GetSampleN()!=aN)||(h5.GetEnd()!=1000000000.0+aN/16.0)||(h5.GetType()!=ogwf_type_real8)){
+    cerr<<"Oh5-test: wrong attributes"<<endl;
+    return false;
+  }
+
+  // hyperslab read inside the file
+  vector<double> buf(100, -1.0);
+  if(h5.Read(1000000010.0, 100, buf.data(), ogwf_type_real8, 16.0)!=100){
+    cerr<<"Oh5-test: cannot read"<<endl;
+    return false;
+  }
+  for(unsigned int i=0; i<100; i++){
+    if(buf[i]!=160.5+i){
+      cerr<<"Oh5-test: sample "<<i<<" = "<<buf[i]<<" instead of "<<160.5+i<<endl;
+      return false;
+    }
+  }
+
+  // partial coverage: the rest of the buffer is not modified
+  buf.assign(100, -1.0);
+  if((h5.Read(1000000000.0-2.0, 100, buf.data(), ogwf_type_real8, 16.0)!=68)||(buf[31]!=-1.0)||(buf[32]!=0.5)||(buf[99]!=67.5)){
+    cerr<<"Oh5-test: wrong partial read (start)"<<endl;
+    return false;
+  }
+  buf.assign(100, -1.0);
+  if((h5.Read(h5.GetEnd()-1.0, 100, buf.data(), ogwf_type_real8, 16.0)!=16)||(buf[0]!=aN-16+0.5)||(buf[15]!=aN-0.5)||(buf[16]!=-1.0)){
+    cerr<<"Oh5-test: wrong partial read (end)"<<endl;
+    return false;
+  }
+
+  // mismatches
+  if((h5.Read(h5.GetEnd()+1.0, 100, buf.data(), ogwf_type_real8, 16.0)!=0)||
+     (h5.Read(1000000010.0, 100, buf.data(), ogwf_type_real4, 16.0)!=0)||
+     (h5.Read(1000000010.0, 100, buf.data(), ogwf_type_real8, 32.0)!=0)){
+    cerr<<"Oh5-test: mismatch accepted"<<endl;
+    return false;
+  }
+
+  // the caller's error handler is restored
+  H5E_auto2_t func = NULL;
+  void *data = NULL;
+  H5Eget_auto2(H5E_DEFAULT, &func, &data);
+  if((func!=TestHandler)||(data!=NULL)||(handler_n!=0)){
+    cerr<<"Oh5-test: the caller's error handler is not restored"<<endl;
+    return false;
+  }
+  hid_t f = H5Fopen("Oh5-test-missing.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+  if((f>=0)||(handler_n==0)){
+    cerr<<"Oh5-test: the caller's error handler is not called"<<endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  const string path = "Oh5-test.h5";
+  const unsigned int n = 1000;
+  if(!WriteFile(path, n)){
+    cerr<<"Oh5-test: cannot write "<<path<<endl;
+    return 1;
+  }
+
+  // caller's error handler
+  H5Eset_auto2(H5E_DEFAULT, TestHandler, NULL);
+
+  bool ok = Check(path, n);
+  remove(path.c_str());
+  if(!ok) return 1;
+
+  // native types
+  if(!CheckTypes("Oh5-test-type.h5")) return 1;
+
+  cout<<"Oh5-test: OK"<<endl;
+  return 0;
+}
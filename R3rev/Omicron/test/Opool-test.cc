@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @brief Test of the Opool class.
+ */
+#include "Opool.h"
+#include <iostream>
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  // every task runs once, on a valid thread
+  for(unsigned int n=1; n<=8; n++){
+    Opool pool(n);
+    if(pool.GetThreadN()!=n){
+      cerr<<"Opool-test: "<<pool.GetThreadN()<<" threads instead of "<<n<<endl;
+      return 1;
+    }
+
+    // the pool is re-used for several lists
+    for(unsigned int l=0; l<50; l++){
+      const unsigned int ntasks = l*7;
+      vector<atomic<unsigned int>> count(ntasks);
+      for(unsigned int i=0; i<ntasks; i++) count[i] = 0;
+      atomic<bool> bad_thread(false);
+      pool.Run(ntasks, [&](const unsigned int aTask, const unsigned int aThread){
+          count[aTask]++;
+          if(aThread>=n) bad_thread = true;
+        });
+      for(unsigned int i=0; i<ntasks; i++){
+        if(count[i]!=1){
+          cerr<<"Opool-test: task "<<i<<" run "<<count[i]<<" times ("<<n<<" threads)"<<endl;
+          return 1;
+        }
+      }
+      if(bad_thread){
+        cerr<<"Opool-test: invalid thread index ("<<n<<" threads)"<<endl;
+        return 1;
+      }
+    }
+  }
+
+  // 1 thread: sequential, in the index order, on the calling thread
+  Opool seq(1);
+  vector<unsigned int> order;
+  seq.Run(10, [&](const unsigned int aTask, const unsigned int aThread){
+      if(aThread==0) order.push_back(aTask);
+    });
+  for(unsigned int i=0; i<10; i++){
+    if((order.size()!=10)||(order[i]!=i)){
+      cerr<<"Opool-test: the 1-thread pool is not sequential"<<endl;
+      return 1;
+    }
+  }
+
+  // 0 thread: hardware threads
+  Opool hw(0);
+  if(hw.GetThreadN()==0){
+    cerr<<"Opool-test: no thread"<<endl;
+    return 1;
+  }
+
+  cout<<"Opool-test: OK"<<endl;
+  return 0;
+}
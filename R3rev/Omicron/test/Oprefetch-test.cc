@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @brief Test of the Oprefetch class.
+ */
+#include "Oprefetch.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Waits until a condition is true.
+ * @returns false if the condition is still false after 5 s.
+ * @param[in] aCondition Condition.
+ */
+static bool WaitFor(function<bool(void)> aCondition){
+  for(unsigned int i=0; i<5000; i++){
+    if(aCondition()) return true;
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  return false;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  const unsigned int size = 1000;
+  atomic<unsigned int> nload(0);
+  atomic<bool> gate(true);
+
+  // loader: channel 99 fails, the samples are start+channel
+  OprefetchLoader loader = [&](const unsigned int aStart, const unsigned int, const unsigned int aChannel,
+                               double **aData, unsigned int &aSize){
+    while(!gate) this_thread::sleep_for(chrono::milliseconds(1));
+    nload++;
+    if(aChannel==99) return false;
+    *aData = new double [size];
+    aSize = size;
+    for(unsigned int i=0; i<size; i++) (*aData)[i] = (double)(aStart+aChannel);
+    return true;
+  };
+
+  double *v;
+  unsigned int n;
+
+  // request and get
+  {
+    Oprefetch pf(loader, 100*size*sizeof(double));
+    pf.Request(1000, 1064, {0, 1, 2, 99});
+    pf.Request(1000, 1064, {1});// already requested
+    for(unsigned int c=0; c<3; c++){
+      if(!pf.Get(1000, 1064, c, &v, n)||(n!=size)||(v[size-1]!=(double)(1000+c))){
+        cerr<<"Oprefetch-test: wrong data for channel "<<c<<endl;
+        return 1;
+      }
+      delete [] v;
+    }
+    if(pf.Get(1000, 1064, 99, &v, n)||(v!=NULL)||(n!=0)){
+      cerr<<"Oprefetch-test: the loader failure is not reported"<<endl;
+      return 1;
+    }
+    if(pf.Get(2000, 2064, 0, &v, n)){
+      cerr<<"Oprefetch-test: data returned without request"<<endl;
+      return 1;
+    }
+    if((nload!=4)||(pf.GetMemoryUsed()!=0)){
+      cerr<<"Oprefetch-test: "<<nload<<" loads, "<<pf.GetMemoryUsed()<<" bytes used"<<endl;
+      return 1;
+    }
+  }
+
+  // memory budget: one vector
+  nload = 0;
+  {
+    Oprefetch pf(loader, size*sizeof(double));
+    pf.Request(1000, 1064, {0, 1, 2});
+    if(!WaitFor([&]{ return pf.GetMemoryUsed()==size*sizeof(double); })){
+      cerr<<"Oprefetch-test: nothing loaded"<<endl;
+      return 1;
+    }
+    this_thread::sleep_for(chrono::milliseconds(50));
+    if(nload!=1){
+      cerr<<"Oprefetch-test: the memory budget is exceeded ("<<nload<<" loads)"<<endl;
+      return 1;
+    }
+    for(unsigned int c=0; c<3; c++){
+      if(!pf.Get(1000, 1064, c, &v, n)){
+        cerr<<"Oprefetch-test: budget: no data for channel "<<c<<endl;
+        return 1;
+      }
+      delete [] v;
+    }
+    if(nload!=3){
+      cerr<<"Oprefetch-test: budget: "<<nload<<" loads"<<endl;
+      return 1;
+    }
+  }
+
+  // cancel: pending requests and the vector being loaded are discarded
+  nload = 0;
+  {
+    Oprefetch pf(loader, 100*size*sizeof(double));
+    gate = false;
+    pf.Request(1000, 1064, {0, 1, 2});
+    pf.Cancel();
+    gate = true;
+    if(!WaitFor([&]{ return nload<=1; })) return 1;
+    this_thread::sleep_for(chrono::milliseconds(50));
+    for(unsigned int c=0; c<3; c++){
+      if(pf.Get(1000, 1064, c, &v, n)){
+        cerr<<"Oprefetch-test: canceled data returned for channel "<<c<<endl;
+        delete [] v;
+        return 1;
+      }
+    }
+    if((nload>1)||(pf.GetMemoryUsed()!=0)){
+      cerr<<"Oprefetch-test: cancel: "<<nload<<" loads, "<<pf.GetMemoryUsed()<<" bytes used"<<endl;
+      return 1;
+    }
+
+    // new requests after a cancel
+    pf.Request(1064, 1128, {5});
+    if(!pf.Get(1064, 1128, 5, &v, n)||(v[0]!=1069.0)){
+      cerr<<"Oprefetch-test: no data after a cancel"<<endl;
+      return 1;
+    }
+    delete [] v;
+
+    // loaded data not collected are deleted by the destructor
+    pf.Request(1128, 1192, {1, 2});
+    WaitFor([&]{ return pf.GetMemoryUsed()==2*size*sizeof(double); });
+  }
+
+  cout<<"Oprefetch-test: OK"<<endl;
+  return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Test of the Oprune class.
+ */
+#include "Oprune.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+
+/**
+ * @brief Checks the pruned transform against a direct inverse Fourier transform.
+ * @returns false if an output sample differs.
+ * @param[in] aSize Transform size.
+ * @param[in] aBlockN Number of output blocks.
+ * @param[in] aGen Random generator.
+ */
+static bool Check(const unsigned int aSize, const unsigned int aBlockN, mt19937 &aGen){
+  uniform_real_distribution<double> u(-1.0, 1.0);
+  Oprune prune(aSize, aBlockN);
+  if(!prune.GetStatus()||(prune.GetBlockSize()*prune.GetBlockN()!=aSize)){
+    cerr<<"Oprune-test: cannot create a transform "<<aSize<<"/"<<aBlockN<<endl;
+    return false;
+  }
+  const unsigned int l = prune.GetBlockSize();
+
+  // input and direct inverse DFT
+  vector<double> x(2*aSize), y(2*aSize);
+  for(unsigned int k=0; k<2*aSize; k++) x[k] = u(aGen);
+  for(unsigned int n=0; n<aSize; n++){
+    long double re = 0.0, im = 0.0;
+    for(unsigned int k=0; k<aSize; k++){
+      long double a = 2.0L*M_PI*(long double)(((long unsigned int)k*n)%aSize)/(long double)aSize;
+      re += x[2*k]*cosl(a)-x[2*k+1]*sinl(a);
+      im += x[2*k]*sinl(a)+x[2*k+1]*cosl(a);
+    }
+    y[2*n] = (double)re;
+    y[2*n+1] = (double)im;
+  }
+
+  // all block ranges
+  vector<double> out(2*aSize);
+  for(unsigned int b0=0; b0<=aBlockN; b0++){
+    for(unsigned int b1=b0; b1<=aBlockN; b1++){
+      out.assign(2*aSize, 0.0);
+      if(!prune.Transform((const fftw_complex*)x.data(), b0, b1, (fftw_complex*)out.data())){
+        cerr<<"Oprune-test: "<<aSize<<"/"<<aBlockN<<": blocks ["<<b0<<", "<<b1<<"[ rejected"<<endl;
+        return false;
+      }
+      for(unsigned int n=b0*l; n<b1*l; n++){
+        unsigned int i = n-b0*l;
+        if((fabs(out[2*i]-y[2*n])>1e-10*aSize)||(fabs(out[2*i+1]-y[2*n+1])>1e-10*aSize)){
+          cerr<<"Oprune-test: "<<aSize<<"/"<<aBlockN<<": sample "<<n<<" = ("<<out[2*i]<<", "<<out[2*i+1]<<") instead of ("<<y[2*n]<<", "<<y[2*n+1]<<")"<<endl;
+          return false;
+        }
+      }
+      for(unsigned int i=(b1-b0)*l; i<aSize; i++){
+        if((out[2*i]!=0.0)||(out[2*i+1]!=0.0)){
+          cerr<<"Oprune-test: "<<aSize<<"/"<<aBlockN<<": write beyond the requested blocks"<<endl;
+          return false;
+        }
+      }
+    }
+  }
+
+  // invalid ranges
+  if(prune.Transform((const fftw_complex*)x.data(), 1, 0, (fftw_complex*)out.data())||
+     prune.Transform((const fftw_complex*)x.data(), 0, aBlockN+1, (fftw_complex*)out.data())){
+    cerr<<"Oprune-test: invalid block range accepted"<<endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 gen(4321);
+  const unsigned int sizes[][2] = {{1, 1}, {16, 4}, {60, 5}, {64, 1}, {64, 64}, {256, 8}, {1024, 16}};
+  for(unsigned int i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+    if(!Check(sizes[i][0], sizes[i][1], gen)) return 1;
+
+  // the number of blocks must divide the size
+  Oprune bad(100, 7);
+  if(bad.GetStatus()){
+    cerr<<"Oprune-test: invalid number of blocks accepted"<<endl;
+    return 1;
+  }
+
+  cout<<"Oprune-test: OK"<<endl;
+  return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @brief Test of the Omedian and Opsd classes.
+ */
+#include "Opsd.h"
+#include <random>
+#include <algorithm>
+
+/**
+ * @brief Returns the median of a vector (brute force).
+ * @param[in] aX Vector (copied).
+ */
+static double Median(vector<double> aX){
+  sort(aX.begin(), aX.end());
+  unsigned int n = aX.size();
+  if(n%2) return aX[n/2];
+  return (aX[n/2-1]+aX[n/2])/2.0;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 rng(2024);
+  normal_distribution<double> gauss(0.0, 1.0);
+  uniform_int_distribution<int> dice(0, 9);
+
+  // running median = brute force (with ties)
+  const unsigned int windows[] = {1, 2, 3, 7, 8, 31};
+  for(unsigned int w=0; w<sizeof(windows)/sizeof(windows[0]); w++){
+    Omedian med(windows[w]);
+    vector<double> stream;
+    for(unsigned int i=0; i<200; i++){
+      double v = (i%3) ? gauss(rng) : (double)dice(rng);
+      med.Add(v);
+      stream.push_back(v);
+      unsigned int n = min((unsigned int)stream.size(), windows[w]);
+      vector<double> last(stream.end()-n, stream.end());
+      if((med.GetN()!=n)||(med.GetMedian()!=Median(last))){
+        cerr<<"Omedian: window "<<windows[w]<<", value "<<i<<": median = "<<med.GetMedian()<<" instead of "<<Median(last)<<endl;
+        return 1;
+      }
+    }
+  }
+
+  // median bias
+  if((Opsd::MedianBias(1)!=1.0)||(fabs(Opsd::MedianBias(3)-(1.0-1.0/2.0+1.0/3.0))>1e-15)||(Opsd::MedianBias(2)!=Opsd::MedianBias(3))){
+    cerr<<"Opsd-test: wrong median bias"<<endl;
+    return 1;
+  }
+
+  // white noise: PSD = 2 sigma^2 / fs
+  const unsigned int fs = 1024, nseg = 256, nwin = 31;
+  const double sigma = 3.0;
+  Opsd psd(fs, nseg, nwin);
+  if((psd.GetBinN()!=nseg/2+1)||(psd.GetFrequencyResolution()!=(double)fs/(double)nseg)){
+    cerr<<"Opsd-test: wrong frequency bins"<<endl;
+    return 1;
+  }
+  vector<double> data((nwin+5)*nseg/2);
+  for(unsigned int i=0; i<data.size(); i++) data[i] = sigma*gauss(rng);
+  unsigned int np = psd.AddData(data.size(), data.data());
+  if((np!=nwin+4)||(psd.GetPeriodogramN()!=nwin)){
+    cerr<<"Opsd-test: "<<np<<" periodograms added, "<<psd.GetPeriodogramN()<<" in the median"<<endl;
+    return 1;
+  }
+  const double expected = 2.0*sigma*sigma/(double)fs;
+  double mean = 0.0;
+  for(unsigned int k=1; k<psd.GetBinN()-1; k++){
+    mean += psd.GetPower(k);
+    if((psd.GetPower(k)<expected/3.0)||(psd.GetPower(k)>3.0*expected)){
+      cerr<<"Opsd-test: white noise: bin "<<k<<": "<<psd.GetPower(k)<<" instead of "<<expected<<endl;
+      return 1;
+    }
+  }
+  mean /= (double)(psd.GetBinN()-2);
+  if(fabs(mean/expected-1.0)>0.08){
+    cerr<<"Opsd-test: white noise: mean PSD = "<<mean<<" instead of "<<expected<<endl;
+    return 1;
+  }
+
+  // interpolation
+  const double df = psd.GetFrequencyResolution();
+  if((psd.GetPower(10.0*df)!=psd.GetPower((unsigned int)10))
+     ||(fabs(psd.GetPower(10.5*df)-(psd.GetPower((unsigned int)10)+psd.GetPower((unsigned int)11))/2.0)>1e-15*expected)
+     ||(psd.GetPower(-1.0)!=0.0)||(psd.GetPower((double)fs)!=0.0)){
+    cerr<<"Opsd-test: wrong interpolation"<<endl;
+    return 1;
+  }
+
+  // sinusoid: the power is in the sinusoid bin
+  psd.Reset();
+  if(psd.GetPeriodogramN()!=0){
+    cerr<<"Opsd-test: the PSD is not reset"<<endl;
+    return 1;
+  }
+  const unsigned int ksin = 40;
+  for(unsigned int i=0; i<data.size(); i++) data[i] = 0.1*gauss(rng)+sin(2.0*M_PI*(double)ksin*df*(double)i/(double)fs);
+  psd.AddData(data.size(), data.data());
+  for(unsigned int k=1; k<psd.GetBinN()-1; k++){
+    if((k+1<ksin||k>ksin+1)&&(psd.GetPower(k)>1e-3*psd.GetPower(ksin))){
+      cerr<<"Opsd-test: sinusoid: power leaks in bin "<<k<<endl;
+      return 1;
+    }
+  }
+
+  cout<<"Opsd-test: OK"<<endl;
+  return 0;
+}
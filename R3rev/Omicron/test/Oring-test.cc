@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @brief Test of the Oring class.
+ */
+#include "Oring.h"
+#include <iostream>
+#include <vector>
+#include <random>
+
+/**
+ * @brief Reference stream: sample value = sample GPS time.
+ * @returns The samples between two GPS times.
+ * @param[in] aTimeStart GPS start time [s].
+ * @param[in] aTimeEnd GPS end time [s].
+ * @param[in] aSamplingFrequency Sampling frequency [Hz].
+ */
+static vector<double> Stream(const unsigned int aTimeStart, const unsigned int aTimeEnd, const unsigned int aSamplingFrequency){
+  vector<double> v((aTimeEnd-aTimeStart)*aSamplingFrequency);
+  for(unsigned int i=0; i<v.size(); i++) v[i] = (double)aTimeStart+(double)i/(double)aSamplingFrequency;
+  return v;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  const unsigned int fs = 16, duration = 64;
+  Oring ring(fs, duration);
+  vector<double> v, out(2*duration*fs);
+  unsigned int rs, re;
+
+  // empty buffer: everything must be read
+  if(ring.Contains(1000, 1001)||!ring.GetMissing(1000, 1064, rs, re)||(rs!=1000)||(re!=1064)){
+    cerr<<"Oring-test: the empty buffer is not empty"<<endl;
+    return 1;
+  }
+
+  // consecutive chunks of random durations (some larger than the capacity)
+  mt19937 rng(1);
+  uniform_int_distribution<unsigned int> dur(1, duration+10);
+  unsigned int t = 1000000000;
+  v = Stream(t, t+10, fs);
+  ring.Put(t, t+10, v.data());
+  t += 10;
+  for(unsigned int c=0; c<200; c++){
+    unsigned int d = dur(rng);
+    v = Stream(t, t+d, fs);
+    ring.Put(t, t+d, v.data());
+    t += d;
+
+    // the buffer holds the last samples, up to the capacity
+    if(ring.GetTimeEnd()!=t){
+      cerr<<"Oring-test: end time = "<<ring.GetTimeEnd()<<" instead of "<<t<<endl;
+      return 1;
+    }
+    if(ring.GetTimeEnd()-ring.GetTimeStart()>duration){
+      cerr<<"Oring-test: capacity exceeded"<<endl;
+      return 1;
+    }
+
+    // every contained range is read back exactly
+    for(unsigned int s=ring.GetTimeStart(); s<ring.GetTimeEnd(); s+=3){
+      for(unsigned int e=s+1; e<=ring.GetTimeEnd(); e+=5){
+        if(!ring.Read(s, e, out.data())){
+          cerr<<"Oring-test: cannot read "<<s<<"-"<<e<<endl;
+          return 1;
+        }
+        v = Stream(s, e, fs);
+        for(unsigned int i=0; i<v.size(); i++){
+          if(out[i]!=v[i]){
+            cerr<<"Oring-test: wrong sample "<<i<<" in "<<s<<"-"<<e<<endl;
+            return 1;
+          }
+        }
+      }
+    }
+    if(ring.Read(ring.GetTimeStart()-1, ring.GetTimeEnd(), out.data())||ring.Read(ring.GetTimeStart(), ring.GetTimeEnd()+1, out.data())){
+      cerr<<"Oring-test: a range out of the buffer is read"<<endl;
+      return 1;
+    }
+  }
+
+  // overlapping chunk: only the part after the buffer end is missing
+  if(!ring.GetMissing(t-10, t+20, rs, re)||(rs!=t)||(re!=t+20)){
+    cerr<<"Oring-test: missing range = "<<rs<<"-"<<re<<endl;
+    return 1;
+  }
+  if(ring.GetMissing(t-10, t, rs, re)){
+    cerr<<"Oring-test: a contained range is missing"<<endl;
+    return 1;
+  }
+
+  // non-contiguous samples: reset
+  v = Stream(t+100, t+110, fs);
+  ring.Put(t+100, t+110, v.data());
+  if((ring.GetTimeStart()!=t+100)||(ring.GetTimeEnd()!=t+110)||ring.Contains(t-1, t)){
+    cerr<<"Oring-test: the buffer is not reset"<<endl;
+    return 1;
+  }
+
+  // zero capacity
+  Oring zero(fs, 0);
+  zero.Put(t, t+1, v.data());
+  if(zero.Contains(t, t+1)){
+    cerr<<"Oring-test: samples in a zero-capacity buffer"<<endl;
+    return 1;
+  }
+
+  cout<<"Oring-test: OK"<<endl;
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @brief Test of the Oscheduler class.
+ */
+#include "Oscheduler.h"
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <sys/mman.h>
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 rng(7);
+  uniform_real_distribution<double> uni(0.0, 100.0);
+  const unsigned int nitems = 500;
+
+  // cost hint
+  if((Oscheduler::GetCost(100.0, 5.0, 10.0)!=150.0)||(Oscheduler::GetCost(100.0, 5.0, 0.0)!=100.0)){
+    cerr<<"Oscheduler-test: wrong cost hint"<<endl;
+    return 1;
+  }
+
+  // threads: every item is processed exactly once
+  for(unsigned int nw=1; nw<=6; nw++){
+    Oscheduler sched(nw);
+    for(unsigned int i=0; i<nitems; i++){
+      if(sched.AddItem(uni(rng))!=i){
+        cerr<<"Oscheduler-test: wrong item index"<<endl;
+        return 1;
+      }
+    }
+    vector<atomic<unsigned int>> count(nitems);
+    for(unsigned int i=0; i<nitems; i++) count[i] = 0;
+    atomic<bool> bad_worker(false);
+    vector<unsigned int> done = sched.RunThreads([&](const unsigned int aItem, const unsigned int aWorker){
+        count[aItem]++;
+        if(aWorker>=nw) bad_worker = true;
+        // uneven actual costs: the first items are slow, which forces stealing
+        if(aItem<nw) this_thread::sleep_for(chrono::milliseconds(20));
+      });
+    unsigned int ndone = 0;
+    for(unsigned int w=0; w<done.size(); w++) ndone += done[w];
+    if(bad_worker||(done.size()!=nw)||(ndone!=nitems)){
+      cerr<<"Oscheduler-test: threads: "<<ndone<<" items processed ("<<nw<<" workers)"<<endl;
+      return 1;
+    }
+    for(unsigned int i=0; i<nitems; i++){
+      if(count[i]!=1){
+        cerr<<"Oscheduler-test: threads: item "<<i<<" processed "<<count[i]<<" times ("<<nw<<" workers)"<<endl;
+        return 1;
+      }
+    }
+  }
+
+  // processes: every item is processed exactly once (counters in shared memory)
+  atomic<unsigned int> *count = (atomic<unsigned int>*)mmap(NULL, nitems*sizeof(atomic<unsigned int>),
+                                                            PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if(count==MAP_FAILED){
+    cerr<<"Oscheduler-test: no shared memory"<<endl;
+    return 1;
+  }
+  Oscheduler psched(4);
+  for(unsigned int i=0; i<nitems; i++) psched.AddItem(uni(rng));
+  for(unsigned int i=0; i<nitems; i++) new(count+i) atomic<unsigned int>(0);
+  int nfail = psched.RunProcesses([&](const unsigned int aItem, const unsigned int aWorker){
+      count[aItem]++;
+      return aWorker<4;
+    });
+  if(nfail!=0){
+    cerr<<"Oscheduler-test: processes: "<<nfail<<" workers failed"<<endl;
+    return 1;
+  }
+  for(unsigned int i=0; i<nitems; i++){
+    if(count[i]!=1){
+      cerr<<"Oscheduler-test: processes: item "<<i<<" processed "<<count[i]<<" times"<<endl;
+      return 1;
+    }
+  }
+
+  // processes: failures are reported
+  nfail = psched.RunProcesses([&](const unsigned int aItem, const unsigned int){
+      return aItem!=0;
+    });
+  if(nfail!=1){
+    cerr<<"Oscheduler-test: processes: "<<nfail<<" failed workers reported instead of 1"<<endl;
+    return 1;
+  }
+  munmap(count, nitems*sizeof(atomic<unsigned int>));
+
+  cout<<"Oscheduler-test: OK"<<endl;
+  return 0;
+}
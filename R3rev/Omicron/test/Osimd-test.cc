@@ -0,0 +1,235 @@
+/**
+ * @file
+ * @brief Test of the Omicron vectorized kernels.
+ * @details The vectorized kernels supported by the CPU must return exactly the same results as the scalar kernels.
+ * The tiles above threshold must be listed in increasing order, as with a brute-force search.
+ * The single-precision kernels must agree with the double-precision kernels within the float rounding.
+ * Tiles with a NaN value must be ignored and the SNR squared must be clamped to 0.
+ */
+#include "Osimd.h"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Compares two arrays bit by bit.
+ * @returns true if the arrays are identical.
+ * @param[in] aName Test name.
+ * @param[in] aA First array.
+ * @param[in] aB Second array.
+ * @param[in] aSize Size [bytes].
+ */
+static bool Same(const string aName, const void *aA, const void *aB, const unsigned int aSize){
+  if(memcmp(aA, aB, aSize)==0) return true;
+  cerr<<"Osimd-test: "<<aName<<": results differ from the scalar kernel"<<endl;
+  return false;
+}
+
+/**
+ * @brief Compares two lists of tile indices.
+ * @returns true if the lists are identical.
+ * @param[in] aName Test name.
+ * @param[in] aN0 Number of indices in the first list.
+ * @param[in] aI0 First list.
+ * @param[in] aN1 Number of indices in the second list.
+ * @param[in] aI1 Second list.
+ */
+static bool SameIndex(const string aName,
+                      const long unsigned int aN0, const vector<unsigned int> &aI0,
+                      const long unsigned int aN1, const vector<unsigned int> &aI1){
+  if((aN0==aN1)&&equal(aI0.begin(), aI0.begin()+aN0, aI1.begin())) return true;
+  cerr<<"Osimd-test: "<<aName<<": tiles above threshold differ ("<<aN1<<" instead of "<<aN0<<")"<<endl;
+  return false;
+}
+
+/**
+ * @brief Checks the SNR squared reduction of tiles with NaN and small values.
+ * @details Tile 1 is loud, the tiles \f$k>1\f$ with \f$k \bmod 8 \in \{1, 6\}\f$ are NaN and the other tiles have \f$|z|^2<2\f$.
+ * The NaN tiles come after the loud tile in the same vector lanes: they must not erase its SNR squared from the lane maximum.
+ * The SNR squared of the small tiles must be 0, so that they are all counted with a threshold equal to 0.
+ * @returns true if all the kernels agree with the expected results.
+ * @param[in] aN Number of tiles.
+ */
+static bool TestNan(const unsigned int aN){
+  const double nan = numeric_limits<double>::quiet_NaN();
+  vector<double> z(2*aN+1, 0.5);
+  vector<float> fz(2*aN+1, 0.5f);
+  long unsigned int nexp = 0;
+  for(unsigned int k=0; k<aN; k++){
+    if((k>1)&&((k%8==1)||(k%8==6))){ z[2*k] = nan; fz[2*k] = (float)nan; }
+    else nexp++;
+  }
+  double mexp = 0.0;
+  if(aN>1){ z[2] = 3.0; fz[2] = 3.0f; mexp = 9.0+0.25-2.0; }// tile 1
+
+  vector<unsigned int> idx(aN+1);
+  long unsigned int n;
+  double m;
+  bool ok = true;
+  for(unsigned int t=0; t<2; t++){// thresholds 0 and -1
+    const double thr = -(double)t;
+    m = OsimdSnrSqScalar(aN, z.data(), thr, n, idx.data());
+    ok &= (m==mexp)&&(n==nexp);
+    m = OsimdSnrSq(aN, z.data(), thr, n);
+    ok &= (m==mexp)&&(n==nexp);
+    m = OsimdSnrSqScalarF(aN, fz.data(), (float)thr, n, idx.data());
+    ok &= (fabs(m-mexp)<1e-6)&&(n==nexp);
+    m = OsimdSnrSq(aN, fz.data(), (float)thr, n);
+    ok &= (fabs(m-mexp)<1e-6)&&(n==nexp);
+#ifdef O_SIMD_X86
+    if(__builtin_cpu_supports("avx2")){
+      m = OsimdSnrSqAvx2(aN, z.data(), thr, n, idx.data());
+      ok &= (m==mexp)&&(n==nexp);
+      m = OsimdSnrSqAvx2F(aN, fz.data(), (float)thr, n, idx.data());
+      ok &= (fabs(m-mexp)<1e-6)&&(n==nexp);
+    }
+    if(__builtin_cpu_supports("avx512f")){
+      m = OsimdSnrSqAvx512(aN, z.data(), thr, n, idx.data());
+      ok &= (m==mexp)&&(n==nexp);
+    }
+#endif
+  }
+
+  // the NaN tiles are not above a positive threshold either
+  m = OsimdSnrSq(aN, z.data(), 1.0, n);
+  ok &= (m==mexp)&&(n==(aN>1 ? 1UL : 0UL));
+
+  if(!ok) cerr<<"Osimd-test: NaN or small tiles are not handled correctly (n="<<aN<<")"<<endl;
+  return ok;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  mt19937 rng(12345);
+  normal_distribution<double> gauss(0.0, 3.0);
+
+  // sizes exercising the vector loops and the scalar tails
+  const unsigned int sizes[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 63, 1000, 1027};
+
+  bool ok = true;
+  for(unsigned int s=0; s<sizeof(sizes)/sizeof(sizes[0]); s++){
+    const unsigned int n = sizes[s];
+    vector<double> x(2*n+1), wr(n+1), wi(n+1), y0(2*n+1), y1(2*n+1), b(n+1);
+    for(unsigned int k=0; k<2*n; k++) x[k] = gauss(rng);
+    for(unsigned int k=0; k<n; k++){ wr[k] = gauss(rng); wi[k] = gauss(rng); b[k] = gauss(rng); }
+    vector<unsigned int> i0(n+1), i1(n+1);
+    long unsigned int n0, n1;
+    double m0, m1;
+
+    // reference
+    OsimdWindowScalar(n, x.data(), wr.data(), wi.data(), y0.data());
+    m0 = OsimdSnrSqScalar(n, x.data(), 20.0, n0, i0.data());
+    double d0 = OsimdDotScalar(n, x.data(), b.data());
+
+    // tiles above threshold: brute force
+    vector<unsigned int> ib(n+1);
+    long unsigned int nb = 0;
+    for(unsigned int k=0; k<n; k++){
+      volatile double rr = x[2*k]*x[2*k], ii = x[2*k+1]*x[2*k+1];
+      if(rr+ii-2.0>=20.0) ib[nb++] = k;
+    }
+    ok &= SameIndex("OsimdSnrSqScalar", nb, ib, n0, i0);
+
+#ifdef O_SIMD_X86
+    if(__builtin_cpu_supports("avx2")){
+      OsimdWindowAvx2(n, x.data(), wr.data(), wi.data(), y1.data());
+      ok &= Same("OsimdWindowAvx2", y0.data(), y1.data(), 2*n*sizeof(double));
+      m1 = OsimdSnrSqAvx2(n, x.data(), 20.0, n1, i1.data());
+      ok &= Same("OsimdSnrSqAvx2", &m0, &m1, sizeof(double));
+      ok &= SameIndex("OsimdSnrSqAvx2", n0, i0, n1, i1);
+      double d1 = OsimdDotAvx2(n, x.data(), b.data());
+      ok &= Same("OsimdDotAvx2", &d0, &d1, sizeof(double));
+    }
+    else cout<<"Osimd-test: no AVX2 support, skipped"<<endl;
+
+    if(__builtin_cpu_supports("avx512f")){
+      OsimdWindowAvx512(n, x.data(), wr.data(), wi.data(), y1.data());
+      ok &= Same("OsimdWindowAvx512", y0.data(), y1.data(), 2*n*sizeof(double));
+      m1 = OsimdSnrSqAvx512(n, x.data(), 20.0, n1, i1.data());
+      ok &= Same("OsimdSnrSqAvx512", &m0, &m1, sizeof(double));
+      ok &= SameIndex("OsimdSnrSqAvx512", n0, i0, n1, i1);
+      double d1 = OsimdDotAvx512(n, x.data(), b.data());
+      ok &= Same("OsimdDotAvx512", &d0, &d1, sizeof(double));
+    }
+    else cout<<"Osimd-test: no AVX-512 support, skipped"<<endl;
+#endif
+
+    // dispatched kernels (the instruction set can be forced with $OMICRON_SIMD)
+    OsimdWindow(n, x.data(), wr.data(), wi.data(), y1.data());
+    ok &= Same("OsimdWindow", y0.data(), y1.data(), 2*n*sizeof(double));
+    m1 = OsimdSnrSq(n, x.data(), 20.0, n1);
+    ok &= Same("OsimdSnrSq", &m0, &m1, sizeof(double));
+    ok &= (n0==n1);
+    m1 = OsimdSnrSq(n, x.data(), 20.0, n1, i1.data());
+    ok &= SameIndex("OsimdSnrSq", n0, i0, n1, i1);
+    double d1 = OsimdDot(n, x.data(), b.data());
+    ok &= Same("OsimdDot", &d0, &d1, sizeof(double));
+
+    // in-place window
+    y1 = x;
+    OsimdWindow(n, y1.data(), wr.data(), wi.data(), y1.data());
+    ok &= Same("OsimdWindow (in place)", y0.data(), y1.data(), 2*n*sizeof(double));
+
+    // single precision: vectorized = scalar
+    vector<float> fwr(n+1), fwi(n+1), fy0(2*n+1), fy1(2*n+1);
+    for(unsigned int k=0; k<n; k++){ fwr[k] = (float)wr[k]; fwi[k] = (float)wi[k]; }
+    OsimdWindowScalarF(n, x.data(), fwr.data(), fwi.data(), fy0.data());
+    float fm0 = (float)OsimdSnrSqScalarF(n, fy0.data(), 20.0f, n0, i0.data());
+    nb = 0;
+    for(unsigned int k=0; k<n; k++){
+      volatile float rr = fy0[2*k]*fy0[2*k], ii = fy0[2*k+1]*fy0[2*k+1];
+      if(rr+ii-2.0f>=20.0f) ib[nb++] = k;
+    }
+    ok &= SameIndex("OsimdSnrSqScalarF", nb, ib, n0, i0);
+#ifdef O_SIMD_X86
+    if(__builtin_cpu_supports("avx2")){
+      OsimdWindowAvx2F(n, x.data(), fwr.data(), fwi.data(), fy1.data());
+      ok &= Same("OsimdWindowAvx2F", fy0.data(), fy1.data(), 2*n*sizeof(float));
+      float fm1 = (float)OsimdSnrSqAvx2F(n, fy0.data(), 20.0f, n1, i1.data());
+      ok &= Same("OsimdSnrSqAvx2F", &fm0, &fm1, sizeof(float));
+      ok &= SameIndex("OsimdSnrSqAvx2F", n0, i0, n1, i1);
+    }
+#endif
+    OsimdWindow(n, x.data(), fwr.data(), fwi.data(), fy1.data());
+    ok &= Same("OsimdWindow (float)", fy0.data(), fy1.data(), 2*n*sizeof(float));
+
+    // single precision: SNR deviation from double precision
+    OsimdWindow(n, x.data(), wr.data(), wi.data(), y1.data());
+    for(unsigned int k=0; k<n; k++){
+      double snrsq_d = y1[2*k]*y1[2*k]+y1[2*k+1]*y1[2*k+1];
+      double snrsq_f = (double)fy1[2*k]*(double)fy1[2*k]+(double)fy1[2*k+1]*(double)fy1[2*k+1];
+      if(snrsq_d<1e-6) continue;
+      if(fabs(snrsq_f/snrsq_d-1.0)>1e-5){
+        cerr<<"Osimd-test: single-precision |z|^2 deviates by "<<fabs(snrsq_f/snrsq_d-1.0)<<" (tile "<<k<<")"<<endl;
+        ok = false;
+        break;
+      }
+    }
+    if(n>0){
+      m0 = OsimdSnrSq(n, y1.data(), 20.0, n0);
+      m1 = OsimdSnrSq(n, fy1.data(), 20.0f, n1);
+      if(fabs(m1-m0)>1e-5*m0){
+        cerr<<"Osimd-test: single-precision maximum SNR^2 "<<m1<<" instead of "<<m0<<endl;
+        ok = false;
+      }
+    }
+
+    if(!ok){
+      cerr<<"Osimd-test: failed for n="<<n<<endl;
+      return 1;
+    }
+  }
+
+  // NaN tiles, SNR squared clamped to 0
+  for(unsigned int s=0; s<sizeof(sizes)/sizeof(sizes[0]); s++)
+    if(!TestNan(sizes[s])) return 1;
+
+  cout<<"Osimd-test: OK ("<<OsimdGetType()<<")"<<endl;
+  return 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file
+ * @brief Test of the Otilecache class.
+ * @details The cache files are written in the working directory and removed at the end.
+ */
+#include "Otilecache.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+/**
+ * @brief Writes a modified copy of a file.
+ * @param[in] aIn Input file path.
+ * @param[in] aOut Output file path.
+ * @param[in] aOffset Offset of the modified bytes.
+ * @param[in] aBytes New bytes.
+ * @param[in] aN Number of new bytes.
+ * @param[in] aSize Output file size (truncation). Use 0 to keep the size.
+ */
+static void Corrupt(const string aIn, const string aOut, const long unsigned int aOffset,
+                    const void *aBytes, const unsigned int aN, const long unsigned int aSize=0){
+  ifstream in(aIn.c_str(), ios::binary);
+  string s((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+  memcpy(&s[aOffset], aBytes, aN);
+  if(aSize>0) s.resize(aSize);
+  ofstream out(aOut.c_str(), ios::binary);
+  out.write(s.data(), s.size());
+}
+
+/**
+ * @brief Checks the cache content.
+ * @returns false if the content differs.
+ * @param[in] aCache Cache.
+ * @param[in] aNames Array names.
+ * @param[in] aArrays Arrays.
+ */
+static bool Check(Otilecache &aCache, const vector<string> &aNames, const vector< vector<double> > &aArrays){
+  if(!aCache.IsValid()||(aCache.GetArrayN()!=aNames.size())||!aCache.ImportWisdom()) return false;
+  for(unsigned int i=0; i<aNames.size(); i++){
+    int a = aCache.FindArray(aNames[i]);
+    if((a!=(int)i)||(aCache.GetArrayName(a)!=aNames[i])||(aCache.GetArraySize(a)!=aArrays[i].size())) return false;
+    if(aArrays[i].size()&&memcmp(aCache.GetArray(a), aArrays[i].data(), aArrays[i].size()*sizeof(double))) return false;
+  }
+  return aCache.FindArray("none")<0;
+}
+
+/**
+ * @brief Writes, reads and corrupts a cache file.
+ * @returns false if a check fails.
+ * @param[in] aFilePath Cache file path.
+ * @param[in] aBadFilePath Corrupted cache file path.
+ * @param[in] aKey Key.
+ * @param[in] aOtherKey Another key.
+ * @param[in] aNames Array names.
+ * @param[in] aArrays Arrays.
+ */
+static bool Run(const string aFilePath, const string aBadFilePath, const string aKey, const string aOtherKey,
+                const vector<string> &aNames, const vector< vector<double> > &aArrays){
+  if(!Otilecache::Write(aFilePath, aKey, aNames, aArrays)){
+    cerr<<"Otilecache-test: cannot write "<<aFilePath<<endl;
+    return false;
+  }
+
+  // read back
+  {
+    Otilecache cache(aFilePath, aKey);
+    if(!Check(cache, aNames, aArrays)){
+      cerr<<"Otilecache-test: wrong cache content"<<endl;
+      return false;
+    }
+  }
+
+  // rejections
+  Otilecache missing("Otilecache-test-missing.otc", aKey);
+  Otilecache other(aFilePath, aOtherKey);
+  if(missing.IsValid()||other.IsValid()||(other.GetArrayN()!=0)||other.ImportWisdom()){
+    cerr<<"Otilecache-test: wrong key accepted"<<endl;
+    return false;
+  }
+
+  // corrupted files
+  ifstream in(aFilePath.c_str(), ios::binary|ios::ate);
+  const long unsigned int size = in.tellg();
+  in.close();
+  const long unsigned int records = 48;// header size
+  const long unsigned int huge = 0xFFFFFFFFFFFFFFF0UL;
+  const long unsigned int bigname = 1000;
+  const long unsigned int bigoffset = 137;
+  const char x = 'x';
+  struct{ long unsigned int offset; const void *bytes; unsigned int n; long unsigned int size; const char *what; } cases[] = {
+    {0, "XTCACHE", 8, 0, "magic"},
+    {0, &x, 0, size-1, "truncated file"},
+    {16, &huge, 8, 0, "data size overflow"},
+    {24, &huge, 8, 0, "key size overflow"},
+    {records, &bigname, 8, 0, "array name offset"},
+    {records+8, &bigoffset, 8, 0, "array offset"},
+    {size-1, &x, 1, 0, "string table end"},
+  };
+  bool ok = true;
+  for(unsigned int c=0; c<sizeof(cases)/sizeof(cases[0]); c++){
+    Corrupt(aFilePath, aBadFilePath, cases[c].offset, cases[c].bytes, cases[c].n, cases[c].size);
+    Otilecache cache(aBadFilePath, aKey);
+    if(cache.IsValid()){
+      cerr<<"Otilecache-test: corrupted file accepted ("<<cases[c].what<<")"<<endl;
+      ok = false;
+    }
+  }
+  if(!ok) return false;
+
+  // no aArrays
+  if(!Otilecache::Write(aFilePath, aKey, {}, {})) return false;
+  Otilecache empty(aFilePath, aKey);
+  if(!empty.IsValid()||(empty.GetArrayN()!=0)||!empty.ImportWisdom()){
+    cerr<<"Otilecache-test: cannot read a cache without arrays"<<endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Test main program.
+ */
+int main(void){
+
+  const string key = Otilecache::MakeKey(64, 4, 3.3166, 100.0, 8.0, 1024.0, 2048, 0.2);
+  const string key2 = Otilecache::MakeKey(64, 4, 3.3166, 100.0, 8.0, 1024.0, 2048, 0.2000000001);
+  if((key==key2)||(Otilecache::MakeFilePath(".", key)==Otilecache::MakeFilePath(".", key2))){
+    cerr<<"Otilecache-test: different parameters give the same key"<<endl;
+    return 1;
+  }
+  const string path = Otilecache::MakeFilePath(".", key);
+  const string bad = "Otilecache-test-bad.otc";
+
+  // arrays: windows and an empty array
+  vector<string> names = {"q0_band0_window", "q0_band1_window", "q0_empty", "q1_band_layout"};
+  vector< vector<double> > arrays(names.size());
+  for(unsigned int i=0; i<100; i++) arrays[0].push_back(1.0/(1.0+i));
+  for(unsigned int i=0; i<37; i++) arrays[1].push_back(-0.5*i);
+  arrays[3] = {8.0, 16.0, 32.0};
+
+  bool ok = Run(path, bad, key, key2, names, arrays);
+  remove(path.c_str());
+  remove(bad.c_str());
+  if(!ok) return 1;
+
+  cout<<"Otilecache-test: OK"<<endl;
+  return 0;
+}
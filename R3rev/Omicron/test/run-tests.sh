@@ -0,0 +1,89 @@
+#!/bin/bash
+#
+# Builds and runs the Omicron helper tests.
+#
+# Each test/*-test.cc program is compiled only with the src/ sources it uses:
+# the "X.h" headers it includes, directly or not, select the src/X.cc sources.
+# The external packages (ROOT, GWOLLUM, HDF5, FFTW, zlib) are also selected from
+# the included headers; their flags are given by root-config and pkg-config.
+# They can be overridden with the OMICRON_TEST_CXXFLAGS and OMICRON_TEST_LIBS
+# environment variables.
+# Set OMICRON_TEST_SANITIZE to "thread" or "address" to build with a sanitizer.
+#
+# Usage: run-tests.sh [test name(s)]
+#
+
+here=$(cd $(dirname $0) && pwd)
+top=$(dirname ${here})
+
+cxxflags="-std=c++17 -O2 -Wall -Wextra -pthread -I${top}/include"
+if [ -n "${OMICRON_TEST_SANITIZE}" ]; then
+    cxxflags="${cxxflags} -g -fsanitize=${OMICRON_TEST_SANITIZE}"
+fi
+
+build=$(mktemp -d)
+trap "rm -rf ${build}" EXIT
+
+# lists the src/ sources and the external packages used by a file (recursive)
+# the results are accumulated in the "sources" and "packages" variables
+scan(){
+    local file=$1
+    local h p
+    for h in $(sed -n 's/^#include "\(.*\)\.h".*/\1/p' ${file}); do
+        [ -f ${top}/include/${h}.h ] || continue
+        case " ${seen} " in *" ${h} "*) continue;; esac
+        seen="${seen} ${h}"
+        scan ${top}/include/${h}.h
+        if [ -f ${top}/src/${h}.cc ]; then
+            sources="${sources} ${h}"
+            scan ${top}/src/${h}.cc
+        fi
+    done
+    for p in $(sed -n 's/^#include <\(CUtils\|TMath\|fftw3\|hdf5\|zlib\)\.h>.*/\1/p' ${file}); do
+        case ${p} in
+            CUtils) packages="${packages} root gwollum";;
+            TMath)  packages="${packages} root";;
+            *)      packages="${packages} ${p}";;
+        esac
+    done
+}
+
+# compilation and link flags of external packages
+flags(){
+    local mode=$1 p pc=""
+    shift
+    for p in $(echo "$@" | tr ' ' '\n' | sort -u); do
+        if [ "${p}" = "root" ]; then root-config --${mode}; else pc="${pc} ${p}"; fi
+    done
+    [ -n "${pc}" ] && pkg-config --${mode} ${pc}
+}
+
+# tests
+if [ $# -eq 0 ]; then
+    tests=$(cd ${here} && ls *-test.cc | sed 's/\.cc$//')
+else
+    tests="$@"
+fi
+
+status=0
+for t in ${tests}; do
+    seen=""; sources=""; packages=""
+    scan ${here}/${t}.cc
+
+    if [ -z "${OMICRON_TEST_CXXFLAGS+x}" ]; then extcxxflags=$(flags cflags ${packages});
+    else extcxxflags=${OMICRON_TEST_CXXFLAGS}; fi
+    if [ -z "${OMICRON_TEST_LIBS+x}" ]; then extlibs=$(flags libs ${packages});
+    else extlibs=${OMICRON_TEST_LIBS}; fi
+
+    objects=""
+    for s in ${sources}; do
+        obj=${build}/${s}.o
+        [ -f ${obj} ] || g++ ${cxxflags} ${extcxxflags} -c ${top}/src/${s}.cc -o ${obj} || { status=1; continue 2; }
+        objects="${objects} ${obj}"
+    done
+
+    g++ ${cxxflags} ${extcxxflags} ${here}/${t}.cc ${objects} -o ${build}/${t} ${extlibs} || { status=1; continue; }
+    (cd ${here} && ${build}/${t}) || { echo "${t}: FAILED"; status=1; }
+done
+
+exit ${status}